@@ -0,0 +1,142 @@
+#include "benchmarks/BenchmarkRunner.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace
+{
+  struct Projection
+  {
+    double last_;
+    double previous_;
+
+    double next(double scale) const noexcept
+    {
+      if (last_ == 0)
+      {
+        return 0;
+      }
+      double growth = previous_ == 0 ? scale : std::max(scale, last_ / previous_);
+      return last_ * growth;
+    }
+
+    void update(double wall) noexcept
+    {
+      previous_ = last_;
+      last_ = wall;
+    }
+  };
+
+  void writeString(std::ostream& out, const std::string& value)
+  {
+    out << '"';
+    for (char c: value)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out << '\\';
+      }
+      out << c;
+    }
+    out << '"';
+  }
+}
+
+bendryshev::BenchmarkRunner::BenchmarkRunner(const Options& options):
+  options_(options),
+  cases_(),
+  results_()
+{}
+
+void bendryshev::BenchmarkRunner::add(BenchmarkCase&& benchmark)
+{
+  cases_.pushBack(std::move(benchmark));
+}
+
+double bendryshev::BenchmarkRunner::measure(const BenchmarkBody& body, std::size_t size, unsigned& repetitions,
+  std::uint64_t& wall) const
+{
+  double best = std::numeric_limits< double >::max();
+  std::uint64_t total = 0;
+  std::uint64_t min_total = static_cast< std::uint64_t >(options_.min_seconds_ * 1e9);
+  repetitions = 0;
+  do
+  {
+    Stopwatch stopwatch;
+    Measurement measurement = body(size);
+    total += stopwatch.elapsed();
+    ++repetitions;
+    double per_operation = static_cast< double >(measurement.nanoseconds_) / std::max< std::size_t >(measurement.operations_, 1);
+    best = std::min(best, per_operation);
+  }
+  while (total < min_total && repetitions < options_.max_repetitions_);
+  wall = total / repetitions;
+  return best;
+}
+
+void bendryshev::BenchmarkRunner::run(std::ostream& progress)
+{
+  double budget = options_.budget_seconds_ * 1e9;
+  for (auto&& benchmark: cases_)
+  {
+    std::string name = benchmark.group_ + '/' + benchmark.operation_;
+    if (name.find(options_.filter_) == std::string::npos)
+    {
+      continue;
+    }
+    Projection subject { 0, 0 };
+    Projection baseline { 0, 0 };
+    std::size_t previous_size = 0;
+    for (std::size_t size = options_.min_size_; size <= options_.max_size_; size *= 10)
+    {
+      double scale = previous_size == 0 ? 1 : static_cast< double >(size) / previous_size;
+      if (subject.next(scale) > budget || baseline.next(scale) > budget)
+      {
+        progress << name << ' ' << size << " skipped: projected time exceeds the budget\n";
+        break;
+      }
+      BenchmarkResult result { benchmark.group_, benchmark.operation_, benchmark.subject_, benchmark.baseline_, size, 0, 0, 0 };
+      std::uint64_t wall = 0;
+      unsigned baseline_repetitions = 0;
+      result.subject_ns_ = measure(benchmark.measure_, size, result.repetitions_, wall);
+      subject.update(static_cast< double >(wall));
+      result.baseline_ns_ = measure(benchmark.measureBaseline_, size, baseline_repetitions, wall);
+      baseline.update(static_cast< double >(wall));
+      progress << name << ' ' << size << ' ' << std::fixed << std::setprecision(2) << result.subject_ns_ << "ns/op ";
+      progress << benchmark.baseline_ << ' ' << result.baseline_ns_ << "ns/op\n";
+      results_.pushBack(std::move(result));
+      previous_size = size;
+      if (size > options_.max_size_ / 10)
+      {
+        break;
+      }
+    }
+  }
+}
+
+void bendryshev::BenchmarkRunner::writeJson(std::ostream& out) const
+{
+  out << "{\n  \"benchmarks\": [";
+  bool first = true;
+  out << std::fixed << std::setprecision(3);
+  for (auto it = results_.cbegin(); it != results_.cend(); ++it)
+  {
+    const BenchmarkResult& result = *it;
+    out << (first ? "\n" : ",\n") << "    { \"group\": ";
+    writeString(out, result.group_);
+    out << ", \"operation\": ";
+    writeString(out, result.operation_);
+    out << ", \"subject\": ";
+    writeString(out, result.subject_);
+    out << ", \"baseline\": ";
+    writeString(out, result.baseline_);
+    out << ", \"size\": " << result.size_;
+    out << ", \"subject_ns_per_op\": " << result.subject_ns_;
+    out << ", \"baseline_ns_per_op\": " << result.baseline_ns_;
+    out << ", \"ratio\": " << (result.baseline_ns_ > 0 ? result.subject_ns_ / result.baseline_ns_ : 0.0);
+    out << ", \"repetitions\": " << result.repetitions_ << " }";
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+}
@@ -0,0 +1,93 @@
+#ifndef S3_BENCHMARKRUNNER_H
+#define S3_BENCHMARKRUNNER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include "data_structures/BidirectionalList.h"
+
+namespace bendryshev
+{
+  struct Measurement
+  {
+    std::uint64_t nanoseconds_;
+    std::size_t operations_;
+  };
+
+  using BenchmarkBody = std::function< Measurement(std::size_t) >;
+
+  struct BenchmarkCase
+  {
+    std::string group_;
+    std::string operation_;
+    std::string subject_;
+    std::string baseline_;
+    BenchmarkBody measure_;
+    BenchmarkBody measureBaseline_;
+  };
+
+  struct BenchmarkResult
+  {
+    std::string group_;
+    std::string operation_;
+    std::string subject_;
+    std::string baseline_;
+    std::size_t size_;
+    double subject_ns_;
+    double baseline_ns_;
+    unsigned repetitions_;
+  };
+
+  class Stopwatch
+  {
+  public:
+    Stopwatch() noexcept:
+      started_(std::chrono::steady_clock::now())
+    {}
+
+    std::uint64_t elapsed() const noexcept
+    {
+      auto duration = std::chrono::steady_clock::now() - started_;
+      return static_cast< std::uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(duration).count());
+    }
+  private:
+    std::chrono::steady_clock::time_point started_;
+  };
+
+  template< typename T >
+  inline void doNotOptimize(const T& value) noexcept
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  class BenchmarkRunner
+  {
+  public:
+    struct Options
+    {
+      std::size_t min_size_;
+      std::size_t max_size_;
+      double budget_seconds_;
+      double min_seconds_;
+      unsigned max_repetitions_;
+      std::string filter_;
+    };
+
+    explicit BenchmarkRunner(const Options&);
+
+    void add(BenchmarkCase&&);
+    void run(std::ostream& progress);
+    void writeJson(std::ostream&) const;
+  private:
+    Options options_;
+    BidirectionalList< BenchmarkCase > cases_;
+    BidirectionalList< BenchmarkResult > results_;
+
+    double measure(const BenchmarkBody&, std::size_t size, unsigned& repetitions, std::uint64_t& wall) const;
+  };
+}
+
+#endif
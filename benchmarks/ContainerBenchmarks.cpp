@@ -0,0 +1,753 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "benchmarks/BenchmarkRunner.h"
+#include "data_structures/BidirectionalList.h"
+#include "data_structures/BinarySearchTree.hpp"
+#include "data_structures/Dequeue.h"
+#include "data_structures/Queue.h"
+#include "data_structures/Stack.h"
+#include "data_structures/TreeDictionary.h"
+
+namespace
+{
+  using bendryshev::Measurement;
+  using bendryshev::Stopwatch;
+  using bendryshev::doNotOptimize;
+
+  struct OwnList
+  {
+    using type = bendryshev::BidirectionalList< int >;
+    using iterator = type::Iterator;
+
+    static void pushBack(type& list, int value)
+    {
+      list.pushBack(value);
+    }
+
+    static void pushFront(type& list, int value)
+    {
+      list.pushFront(value);
+    }
+
+    static void popBack(type& list)
+    {
+      list.popBack();
+    }
+
+    static void popFront(type& list)
+    {
+      list.popFront();
+    }
+
+    static iterator insert(type& list, iterator it, int value)
+    {
+      return list.insertBefore(value, it);
+    }
+
+    static iterator erase(type& list, iterator it)
+    {
+      return list.erase(it);
+    }
+
+    static bool contains(type& list, int value)
+    {
+      return list.find(value) != list.end();
+    }
+
+    static bool equal(type& lhs, type& rhs)
+    {
+      return lhs == rhs;
+    }
+  };
+
+  struct StdList
+  {
+    using type = std::list< int >;
+    using iterator = type::iterator;
+
+    static void pushBack(type& list, int value)
+    {
+      list.push_back(value);
+    }
+
+    static void pushFront(type& list, int value)
+    {
+      list.push_front(value);
+    }
+
+    static void popBack(type& list)
+    {
+      list.pop_back();
+    }
+
+    static void popFront(type& list)
+    {
+      list.pop_front();
+    }
+
+    static iterator insert(type& list, iterator it, int value)
+    {
+      return list.insert(it, value);
+    }
+
+    static iterator erase(type& list, iterator it)
+    {
+      return list.erase(it);
+    }
+
+    static bool contains(type& list, int value)
+    {
+      return std::find(list.begin(), list.end(), value) != list.end();
+    }
+
+    static bool equal(type& lhs, type& rhs)
+    {
+      return lhs == rhs;
+    }
+  };
+
+  struct OwnTree
+  {
+    using type = bendryshev::BinarySearchTree< int, int, std::less< > >;
+
+    static void insert(type& tree, int key)
+    {
+      tree.insert(std::make_pair(key, key));
+    }
+
+    static const int* find(type& tree, int key)
+    {
+      return tree.findValue(key);
+    }
+
+    static void remove(type& tree, int key)
+    {
+      tree.remove(key);
+    }
+
+    template< typename F >
+    static F ascending(type& tree, F f)
+    {
+      return tree.traverse_lnr(f);
+    }
+
+    template< typename F >
+    static F descending(type& tree, F f)
+    {
+      return tree.traverse_rnl(f);
+    }
+
+    template< typename F >
+    static F breadth(type& tree, F f)
+    {
+      return tree.traverse_breadth(f);
+    }
+  };
+
+  struct OwnDictionary
+  {
+    using type = bendryshev::TreeDictionary< int, int, std::less< > >;
+
+    static void insert(type& dictionary, int key)
+    {
+      dictionary.push(key, key);
+    }
+
+    static const int* find(type& dictionary, int key)
+    {
+      return dictionary.lookup(key);
+    }
+
+    static void remove(type& dictionary, int key)
+    {
+      dictionary.drop(key);
+    }
+
+    template< typename F >
+    static F ascending(type& dictionary, F f)
+    {
+      return dictionary.traverse_lnr(f);
+    }
+
+    template< typename F >
+    static F descending(type& dictionary, F f)
+    {
+      return dictionary.traverse_rnl(f);
+    }
+
+    template< typename F >
+    static F breadth(type& dictionary, F f)
+    {
+      return dictionary.traverse_breadth(f);
+    }
+  };
+
+  struct StdMap
+  {
+    using type = std::map< int, int >;
+
+    static void insert(type& map, int key)
+    {
+      map.emplace(key, key);
+    }
+
+    static const int* find(type& map, int key)
+    {
+      auto it = map.find(key);
+      return it == map.end() ? nullptr : std::addressof(it->second);
+    }
+
+    static void remove(type& map, int key)
+    {
+      map.erase(key);
+    }
+
+    template< typename F >
+    static F ascending(type& map, F f)
+    {
+      for (auto&& item: map)
+      {
+        f(item);
+      }
+      return f;
+    }
+
+    template< typename F >
+    static F descending(type& map, F f)
+    {
+      for (auto it = map.crbegin(); it != map.crend(); ++it)
+      {
+        f(*it);
+      }
+      return f;
+    }
+
+    template< typename F >
+    static F breadth(type& map, F f)
+    {
+      return ascending(map, f);
+    }
+  };
+
+  struct OwnStack
+  {
+    using type = bendryshev::Stack< int >;
+
+    static void push(type& stack, int value)
+    {
+      stack.push(value);
+    }
+
+    static int take(type& stack)
+    {
+      int value = stack.getTop();
+      stack.drop();
+      return value;
+    }
+  };
+
+  struct OwnQueue
+  {
+    using type = bendryshev::Queue< int >;
+
+    static void push(type& queue, int value)
+    {
+      queue.push(value);
+    }
+
+    static int take(type& queue)
+    {
+      int value = queue.getNext();
+      queue.drop();
+      return value;
+    }
+  };
+
+  struct OwnDequeue
+  {
+    using type = bendryshev::Dequeue< int >;
+
+    static void push(type& dequeue, int value)
+    {
+      dequeue.pushFront(value);
+    }
+
+    static int take(type& dequeue)
+    {
+      int value = dequeue.getFront();
+      dequeue.dropFront();
+      return value;
+    }
+  };
+
+  struct StdDequeStack
+  {
+    using type = std::deque< int >;
+
+    static void push(type& deque, int value)
+    {
+      deque.push_back(value);
+    }
+
+    static int take(type& deque)
+    {
+      int value = deque.back();
+      deque.pop_back();
+      return value;
+    }
+  };
+
+  struct StdDequeQueue
+  {
+    using type = std::deque< int >;
+
+    static void push(type& deque, int value)
+    {
+      deque.push_back(value);
+    }
+
+    static int take(type& deque)
+    {
+      int value = deque.front();
+      deque.pop_front();
+      return value;
+    }
+  };
+
+  struct StdDequeFront
+  {
+    using type = std::deque< int >;
+
+    static void push(type& deque, int value)
+    {
+      deque.push_front(value);
+    }
+
+    static int take(type& deque)
+    {
+      int value = deque.front();
+      deque.pop_front();
+      return value;
+    }
+  };
+
+  template< typename List >
+  typename List::type makeList(std::size_t size)
+  {
+    typename List::type list;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      List::pushBack(list, static_cast< int >(i));
+    }
+    return list;
+  }
+
+  std::vector< int > shuffledKeys(std::size_t size)
+  {
+    std::vector< int > keys(size);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(static_cast< unsigned >(size)));
+    return keys;
+  }
+
+  template< typename List >
+  Measurement listPushBack(std::size_t size)
+  {
+    typename List::type list;
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      List::pushBack(list, static_cast< int >(i));
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename List >
+  Measurement listPushFront(std::size_t size)
+  {
+    typename List::type list;
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      List::pushFront(list, static_cast< int >(i));
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename List >
+  Measurement listPopBack(std::size_t size)
+  {
+    typename List::type list = makeList< List >(size);
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      List::popBack(list);
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename List >
+  Measurement listPopFront(std::size_t size)
+  {
+    typename List::type list = makeList< List >(size);
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      List::popFront(list);
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename List >
+  Measurement listInsert(std::size_t size)
+  {
+    typename List::type list = makeList< List >(2);
+    auto it = list.begin();
+    ++it;
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      List::insert(list, it, static_cast< int >(i));
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename List >
+  Measurement listErase(std::size_t size)
+  {
+    typename List::type list = makeList< List >(size);
+    std::size_t erased = 0;
+    Stopwatch stopwatch;
+    for (auto it = list.begin(); it != list.end(); ++it)
+    {
+      it = List::erase(list, it);
+      ++erased;
+      if (it == list.end())
+      {
+        break;
+      }
+    }
+    return Measurement { stopwatch.elapsed(), erased };
+  }
+
+  template< typename List >
+  Measurement listFind(std::size_t size)
+  {
+    constexpr std::size_t probes = 16;
+    typename List::type list = makeList< List >(size);
+    std::size_t scanned = 0;
+    Stopwatch stopwatch;
+    for (std::size_t i = 1; i <= probes; ++i)
+    {
+      std::size_t target = size * i / probes;
+      doNotOptimize(List::contains(list, static_cast< int >(target)));
+      scanned += std::min(target + 1, size);
+    }
+    return Measurement { stopwatch.elapsed(), scanned };
+  }
+
+  template< typename List >
+  Measurement listCopy(std::size_t size)
+  {
+    typename List::type list = makeList< List >(size);
+    Stopwatch stopwatch;
+    typename List::type copy(list);
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(copy);
+    return Measurement { elapsed, size };
+  }
+
+  template< typename List >
+  Measurement listEqual(std::size_t size)
+  {
+    typename List::type lhs = makeList< List >(size);
+    typename List::type rhs = makeList< List >(size);
+    Stopwatch stopwatch;
+    doNotOptimize(List::equal(lhs, rhs));
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename Tree >
+  typename Tree::type makeTree(const std::vector< int >& keys)
+  {
+    typename Tree::type tree;
+    for (int key: keys)
+    {
+      Tree::insert(tree, key);
+    }
+    return tree;
+  }
+
+  template< typename Tree >
+  Measurement treeInsert(std::size_t size)
+  {
+    std::vector< int > keys = shuffledKeys(size);
+    typename Tree::type tree;
+    Stopwatch stopwatch;
+    for (int key: keys)
+    {
+      Tree::insert(tree, key);
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename Tree >
+  Measurement treeFind(std::size_t size)
+  {
+    std::vector< int > keys = shuffledKeys(size);
+    typename Tree::type tree = makeTree< Tree >(keys);
+    std::reverse(keys.begin(), keys.end());
+    Stopwatch stopwatch;
+    for (int key: keys)
+    {
+      doNotOptimize(Tree::find(tree, key));
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename Tree >
+  Measurement treeRemove(std::size_t size)
+  {
+    std::vector< int > keys = shuffledKeys(size);
+    typename Tree::type tree = makeTree< Tree >(keys);
+    std::reverse(keys.begin(), keys.end());
+    Stopwatch stopwatch;
+    for (int key: keys)
+    {
+      Tree::remove(tree, key);
+    }
+    return Measurement { stopwatch.elapsed(), size };
+  }
+
+  template< typename Tree >
+  Measurement treeIterate(std::size_t size)
+  {
+    typename Tree::type tree = makeTree< Tree >(shuffledKeys(size));
+    long sum = 0;
+    Stopwatch stopwatch;
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it)
+    {
+      sum += it->second;
+    }
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(sum);
+    return Measurement { elapsed, size };
+  }
+
+  struct SumValues
+  {
+    long sum_;
+
+    template< typename Item >
+    void operator()(const Item& item)
+    {
+      sum_ += item.second;
+    }
+  };
+
+  template< typename Tree >
+  Measurement treeAscending(std::size_t size)
+  {
+    typename Tree::type tree = makeTree< Tree >(shuffledKeys(size));
+    Stopwatch stopwatch;
+    SumValues result = Tree::ascending(tree, SumValues { 0 });
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(result.sum_);
+    return Measurement { elapsed, size };
+  }
+
+  template< typename Tree >
+  Measurement treeDescending(std::size_t size)
+  {
+    typename Tree::type tree = makeTree< Tree >(shuffledKeys(size));
+    Stopwatch stopwatch;
+    SumValues result = Tree::descending(tree, SumValues { 0 });
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(result.sum_);
+    return Measurement { elapsed, size };
+  }
+
+  template< typename Tree >
+  Measurement treeBreadth(std::size_t size)
+  {
+    typename Tree::type tree = makeTree< Tree >(shuffledKeys(size));
+    // The first walk sizes the level buffer, the measured one reuses it.
+    Tree::breadth(tree, SumValues { 0 });
+    Stopwatch stopwatch;
+    SumValues result = Tree::breadth(tree, SumValues { 0 });
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(result.sum_);
+    return Measurement { elapsed, size };
+  }
+
+  template< typename Adapter >
+  Measurement adapterPushTake(std::size_t size)
+  {
+    typename Adapter::type adapter;
+    long sum = 0;
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      Adapter::push(adapter, static_cast< int >(i));
+    }
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      sum += Adapter::take(adapter);
+    }
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(sum);
+    return Measurement { elapsed, 2 * size };
+  }
+
+  template< typename Adapter >
+  Measurement adapterInterleaved(std::size_t size)
+  {
+    typename Adapter::type adapter;
+    long sum = 0;
+    Stopwatch stopwatch;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      Adapter::push(adapter, static_cast< int >(i));
+      Adapter::push(adapter, static_cast< int >(i));
+      sum += Adapter::take(adapter);
+    }
+    std::uint64_t elapsed = stopwatch.elapsed();
+    doNotOptimize(sum);
+    return Measurement { elapsed, 3 * size };
+  }
+
+  void addListCases(bendryshev::BenchmarkRunner& runner)
+  {
+    const char* group = "BidirectionalList";
+    runner.add({ group, "pushBack", group, "std::list", listPushBack< OwnList >, listPushBack< StdList > });
+    runner.add({ group, "pushFront", group, "std::list", listPushFront< OwnList >, listPushFront< StdList > });
+    runner.add({ group, "popBack", group, "std::list", listPopBack< OwnList >, listPopBack< StdList > });
+    runner.add({ group, "popFront", group, "std::list", listPopFront< OwnList >, listPopFront< StdList > });
+    runner.add({ group, "insert", group, "std::list", listInsert< OwnList >, listInsert< StdList > });
+    runner.add({ group, "erase", group, "std::list", listErase< OwnList >, listErase< StdList > });
+    runner.add({ group, "find", group, "std::list", listFind< OwnList >, listFind< StdList > });
+    runner.add({ group, "copy", group, "std::list", listCopy< OwnList >, listCopy< StdList > });
+    runner.add({ group, "equal", group, "std::list", listEqual< OwnList >, listEqual< StdList > });
+  }
+
+  void addTreeCases(bendryshev::BenchmarkRunner& runner)
+  {
+    const char* tree = "BinarySearchTree";
+    runner.add({ tree, "insert", tree, "std::map", treeInsert< OwnTree >, treeInsert< StdMap > });
+    runner.add({ tree, "find", tree, "std::map", treeFind< OwnTree >, treeFind< StdMap > });
+    runner.add({ tree, "remove", tree, "std::map", treeRemove< OwnTree >, treeRemove< StdMap > });
+    runner.add({ tree, "iterate", tree, "std::map", treeIterate< OwnTree >, treeIterate< StdMap > });
+    runner.add({ tree, "traverse_lnr", tree, "std::map", treeAscending< OwnTree >, treeAscending< StdMap > });
+    runner.add({ tree, "traverse_rnl", tree, "std::map", treeDescending< OwnTree >, treeDescending< StdMap > });
+    runner.add({ tree, "traverse_breadth", tree, "std::map", treeBreadth< OwnTree >, treeBreadth< StdMap > });
+    const char* dictionary = "TreeDictionary";
+    runner.add({ dictionary, "push", dictionary, "std::map", treeInsert< OwnDictionary >, treeInsert< StdMap > });
+    runner.add({ dictionary, "lookup", dictionary, "std::map", treeFind< OwnDictionary >, treeFind< StdMap > });
+    runner.add({ dictionary, "drop", dictionary, "std::map", treeRemove< OwnDictionary >, treeRemove< StdMap > });
+    runner.add({ dictionary, "iterate", dictionary, "std::map", treeIterate< OwnDictionary >, treeIterate< StdMap > });
+    runner.add({ dictionary, "traverse_lnr", dictionary, "std::map", treeAscending< OwnDictionary >, treeAscending< StdMap > });
+  }
+
+  void addAdapterCases(bendryshev::BenchmarkRunner& runner)
+  {
+    runner.add({ "Stack", "pushDrop", "Stack", "std::deque", adapterPushTake< OwnStack >, adapterPushTake< StdDequeStack > });
+    runner.add({ "Stack", "interleaved", "Stack", "std::deque", adapterInterleaved< OwnStack >,
+      adapterInterleaved< StdDequeStack > });
+    runner.add({ "Queue", "pushDrop", "Queue", "std::deque", adapterPushTake< OwnQueue >, adapterPushTake< StdDequeQueue > });
+    runner.add({ "Queue", "interleaved", "Queue", "std::deque", adapterInterleaved< OwnQueue >,
+      adapterInterleaved< StdDequeQueue > });
+    runner.add({ "Dequeue", "pushDrop", "Dequeue", "std::deque", adapterPushTake< OwnDequeue >,
+      adapterPushTake< StdDequeFront > });
+    runner.add({ "Dequeue", "interleaved", "Dequeue", "std::deque", adapterInterleaved< OwnDequeue >,
+      adapterInterleaved< StdDequeFront > });
+  }
+
+  bool parseSize(const char* text, std::size_t& size)
+  {
+    char* last = nullptr;
+    unsigned long long value = std::strtoull(text, std::addressof(last), 10);
+    if (*last != '\0' || value == 0)
+    {
+      return false;
+    }
+    size = static_cast< std::size_t >(value);
+    return true;
+  }
+
+  bool parseSeconds(const char* text, double& seconds)
+  {
+    char* last = nullptr;
+    seconds = std::strtod(text, std::addressof(last));
+    return *last == '\0' && seconds > 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bendryshev::BenchmarkRunner::Options options { 10, 10000000, 10.0, 0.05, 1000, std::string() };
+  const char* json_file = nullptr;
+  for (int i = 1; i < argc; ++i)
+  {
+    bool parsed = i + 1 < argc;
+    if (parsed && std::strcmp(argv[i], "--json") == 0)
+    {
+      json_file = argv[++i];
+    }
+    else if (parsed && std::strcmp(argv[i], "--filter") == 0)
+    {
+      options.filter_ = argv[++i];
+    }
+    else if (parsed && std::strcmp(argv[i], "--min-size") == 0)
+    {
+      parsed = parseSize(argv[++i], options.min_size_);
+    }
+    else if (parsed && std::strcmp(argv[i], "--max-size") == 0)
+    {
+      parsed = parseSize(argv[++i], options.max_size_);
+    }
+    else if (parsed && std::strcmp(argv[i], "--budget") == 0)
+    {
+      parsed = parseSeconds(argv[++i], options.budget_seconds_);
+    }
+    else if (parsed && std::strcmp(argv[i], "--min-time") == 0)
+    {
+      parsed = parseSeconds(argv[++i], options.min_seconds_);
+    }
+    else
+    {
+      parsed = false;
+    }
+    if (!parsed)
+    {
+      std::cerr << "Wrong command line params\n";
+      return 1;
+    }
+  }
+  bendryshev::BenchmarkRunner runner(options);
+  addListCases(runner);
+  addTreeCases(runner);
+  addAdapterCases(runner);
+  runner.run(std::cerr);
+  if (!json_file)
+  {
+    runner.writeJson(std::cout);
+    return 0;
+  }
+  std::ofstream out(json_file);
+  runner.writeJson(out);
+  if (!out)
+  {
+    std::cerr << "Results can not be written\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  struct LengthDistribution
+  {
+    enum Kind
+    {
+      fixed,
+      uniform,
+      skewed
+    };
+
+    Kind kind_;
+    unsigned long min_;
+    unsigned long max_;
+  };
+
+  struct MixEntry
+  {
+    std::string keyword_;
+    unsigned weight_;
+  };
+
+  struct Options
+  {
+    unsigned long lists_ = 1000;
+    unsigned long commands_ = 100000;
+    unsigned long values_ = 16;
+    unsigned long positions_ = 16;
+    unsigned long seed_ = 1;
+    LengthDistribution length_ = { LengthDistribution::uniform, 0, 100 };
+    std::vector< MixEntry > mix_;
+    const char* list_file_ = "workload.lists";
+    const char* script_file_ = "workload.commands";
+  };
+
+  const char* const keywords[] =
+  {
+    "print", "replace", "remove", "concat", "equal", "begin", "end", "find", "mismatch", "printPos", "swap", "search"
+  };
+
+  bool parseNumber(const char* first, const char* last, unsigned long& value)
+  {
+    if (first == last)
+    {
+      return false;
+    }
+    char* parsed = nullptr;
+    value = std::strtoul(first, std::addressof(parsed), 10);
+    return parsed == last;
+  }
+
+  bool parseLength(const std::string& spec, LengthDistribution& length)
+  {
+    std::size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    const char* bounds = colon == std::string::npos ? nullptr : spec.c_str() + colon + 1;
+    if (!bounds)
+    {
+      return false;
+    }
+    const char* bounds_end = spec.c_str() + spec.size();
+    if (kind == "fixed")
+    {
+      length.kind_ = LengthDistribution::fixed;
+      if (!parseNumber(bounds, bounds_end, length.min_))
+      {
+        return false;
+      }
+      length.max_ = length.min_;
+      return true;
+    }
+    length.kind_ = kind == "uniform" ? LengthDistribution::uniform : LengthDistribution::skewed;
+    if (kind != "uniform" && kind != "skewed")
+    {
+      return false;
+    }
+    const char* separator = std::strchr(bounds, ':');
+    return separator && parseNumber(bounds, separator, length.min_) && parseNumber(separator + 1, bounds_end, length.max_)
+      && length.min_ <= length.max_;
+  }
+
+  std::vector< MixEntry > presetMix(const std::string& name)
+  {
+    if (name == "print")
+    {
+      return { { "print", 60 }, { "equal", 15 }, { "printPos", 10 }, { "concat", 5 }, { "begin", 5 }, { "find", 5 } };
+    }
+    if (name == "mutate")
+    {
+      return { { "replace", 35 }, { "remove", 35 }, { "concat", 10 }, { "print", 10 }, { "equal", 10 } };
+    }
+    if (name == "position")
+    {
+      return
+      {
+        { "begin", 15 }, { "end", 15 }, { "find", 20 }, { "mismatch", 15 }, { "printPos", 20 }, { "swap", 10 }, { "search", 5 }
+      };
+    }
+    return {};
+  }
+
+  bool parseMix(const std::string& spec, std::vector< MixEntry >& mix)
+  {
+    mix = presetMix(spec);
+    if (!mix.empty())
+    {
+      return true;
+    }
+    std::size_t first = 0;
+    while (first < spec.size())
+    {
+      std::size_t last = spec.find(',', first);
+      last = last == std::string::npos ? spec.size() : last;
+      std::size_t equals = spec.find('=', first);
+      unsigned long weight = 0;
+      if (equals >= last || !parseNumber(spec.c_str() + equals + 1, spec.c_str() + last, weight))
+      {
+        return false;
+      }
+      std::string keyword = spec.substr(first, equals - first);
+      bool known = false;
+      for (const char* candidate: keywords)
+      {
+        known = known || keyword == candidate;
+      }
+      if (!known)
+      {
+        return false;
+      }
+      mix.push_back(MixEntry { keyword, static_cast< unsigned >(weight) });
+      first = last + 1;
+    }
+    return !mix.empty();
+  }
+
+  class Generator
+  {
+  public:
+    explicit Generator(const Options& options):
+      options_(options),
+      random_(options.seed_),
+      total_weight_(0)
+    {
+      for (auto&& entry: options_.mix_)
+      {
+        total_weight_ += entry.weight_;
+      }
+    }
+
+    void writeLists(std::ostream& out)
+    {
+      for (unsigned long i = 0; i < options_.lists_; ++i)
+      {
+        out << 'l' << i;
+        unsigned long length = nextLength();
+        for (unsigned long j = 0; j < length; ++j)
+        {
+          out << ' ' << value();
+        }
+        out << '\n';
+      }
+    }
+
+    void writeCommands(std::ostream& out)
+    {
+      for (unsigned long i = 0; i < options_.commands_; ++i)
+      {
+        writeCommand(out, pickKeyword());
+      }
+    }
+  private:
+    const Options& options_;
+    std::mt19937_64 random_;
+    unsigned long total_weight_;
+
+    unsigned long below(unsigned long bound)
+    {
+      return bound == 0 ? 0 : std::uniform_int_distribution< unsigned long >(0, bound - 1)(random_);
+    }
+
+    unsigned long nextLength()
+    {
+      const LengthDistribution& length = options_.length_;
+      if (length.kind_ == LengthDistribution::uniform)
+      {
+        return length.min_ + below(length.max_ - length.min_ + 1);
+      }
+      if (length.kind_ == LengthDistribution::skewed)
+      {
+        double low = std::log(static_cast< double >(length.min_) + 1);
+        double high = std::log(static_cast< double >(length.max_) + 1);
+        double sample = std::uniform_real_distribution< double >(low, high)(random_);
+        return std::min(length.max_, static_cast< unsigned long >(std::exp(sample)) - 1);
+      }
+      return length.min_;
+    }
+
+    unsigned long value()
+    {
+      return below(options_.values_);
+    }
+
+    std::string list()
+    {
+      return 'l' + std::to_string(below(options_.lists_));
+    }
+
+    std::string concatTarget()
+    {
+      return 'c' + std::to_string(below(options_.lists_ / 4 + 1));
+    }
+
+    std::string anyList()
+    {
+      return below(4) == 0 ? concatTarget() : list();
+    }
+
+    std::string position()
+    {
+      return 'p' + std::to_string(below(options_.positions_));
+    }
+
+    const std::string& pickKeyword()
+    {
+      unsigned long pick = below(total_weight_);
+      for (auto&& entry: options_.mix_)
+      {
+        if (pick < entry.weight_)
+        {
+          return entry.keyword_;
+        }
+        pick -= entry.weight_;
+      }
+      return options_.mix_.back().keyword_;
+    }
+
+    void writeCommand(std::ostream& out, const std::string& keyword)
+    {
+      if (keyword == "print")
+      {
+        out << "print " << anyList() << '\n';
+      }
+      else if (keyword == "replace")
+      {
+        out << "replace " << list() << ' ' << value() << ' ' << value() << '\n';
+      }
+      else if (keyword == "remove")
+      {
+        out << "remove " << list() << ' ';
+        if (below(5) == 0)
+        {
+          out << list() << '\n';
+        }
+        else
+        {
+          out << value() << '\n';
+        }
+      }
+      else if (keyword == "concat")
+      {
+        out << "concat " << concatTarget() << ' ' << list() << ' ' << list() << '\n';
+      }
+      else if (keyword == "equal")
+      {
+        std::string name = anyList();
+        out << "equal " << name << ' ' << (below(2) == 0 ? name : anyList()) << '\n';
+      }
+      else if (keyword == "begin" || keyword == "end")
+      {
+        out << keyword << ' ' << position() << ' ' << anyList() << '\n';
+      }
+      else if (keyword == "find")
+      {
+        out << "find " << position() << ' ' << list() << ' ' << value() << '\n';
+      }
+      else if (keyword == "mismatch")
+      {
+        out << "mismatch " << position() << ' ' << list() << ' ' << anyList() << '\n';
+      }
+      else if (keyword == "printPos")
+      {
+        out << "printPos " << position() << '\n';
+      }
+      else if (keyword == "swap")
+      {
+        out << "swap " << position() << ' ' << position() << '\n';
+      }
+      else if (keyword == "search")
+      {
+        std::string name = list();
+        std::string first = position();
+        std::string last = position();
+        out << "begin " << first << ' ' << name << '\n';
+        out << "end " << last << ' ' << name << '\n';
+        out << "search " << position() << ' ' << first << ' ' << last << ' ' << value() << '\n';
+      }
+    }
+  };
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  options.mix_ = presetMix("print");
+  for (int i = 1; i < argc; i += 2)
+  {
+    bool parsed = i + 1 < argc;
+    const char* argument = parsed ? argv[i + 1] : "";
+    const char* argument_end = argument + std::strlen(argument);
+    if (std::strcmp(argv[i], "--lists") == 0)
+    {
+      parsed = parsed && parseNumber(argument, argument_end, options.lists_) && options.lists_ != 0;
+    }
+    else if (std::strcmp(argv[i], "--commands") == 0)
+    {
+      parsed = parsed && parseNumber(argument, argument_end, options.commands_);
+    }
+    else if (std::strcmp(argv[i], "--values") == 0)
+    {
+      parsed = parsed && parseNumber(argument, argument_end, options.values_) && options.values_ != 0;
+    }
+    else if (std::strcmp(argv[i], "--positions") == 0)
+    {
+      parsed = parsed && parseNumber(argument, argument_end, options.positions_) && options.positions_ != 0;
+    }
+    else if (std::strcmp(argv[i], "--seed") == 0)
+    {
+      parsed = parsed && parseNumber(argument, argument_end, options.seed_);
+    }
+    else if (std::strcmp(argv[i], "--length") == 0)
+    {
+      parsed = parsed && parseLength(argument, options.length_);
+    }
+    else if (std::strcmp(argv[i], "--mix") == 0)
+    {
+      parsed = parsed && parseMix(argument, options.mix_);
+    }
+    else if (std::strcmp(argv[i], "--list-file") == 0)
+    {
+      options.list_file_ = argument;
+    }
+    else if (std::strcmp(argv[i], "--script") == 0)
+    {
+      options.script_file_ = argument;
+    }
+    else
+    {
+      parsed = false;
+    }
+    if (!parsed)
+    {
+      std::cerr << "Wrong command line params\n";
+      return 1;
+    }
+  }
+  Generator generator(options);
+  std::ofstream lists(options.list_file_);
+  generator.writeLists(lists);
+  std::ofstream script(options.script_file_);
+  generator.writeCommands(script);
+  if (!lists || !script)
+  {
+    std::cerr << "Workload can not be written\n";
+    return 1;
+  }
+  return 0;
+}
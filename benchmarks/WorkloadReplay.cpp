@@ -0,0 +1,160 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "benchmarks/BenchmarkRunner.h"
+#include "commands/CommandStats.h"
+#include "commands/ListsCommandMaker.h"
+#include "io/OutputSink.h"
+
+namespace
+{
+  struct Options
+  {
+    const char* list_file_ = nullptr;
+    const char* script_file_ = nullptr;
+    unsigned long repeat_ = 1;
+    bool lazy_ = false;
+    bool dump_stats_ = false;
+  };
+
+  bool parseOptions(int argc, char** argv, Options& options)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], "--lazy") == 0)
+      {
+        options.lazy_ = true;
+      }
+      else if (std::strcmp(argv[i], "--stats") == 0)
+      {
+        options.dump_stats_ = true;
+      }
+      else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+      {
+        char* last = nullptr;
+        options.repeat_ = std::strtoul(argv[++i], std::addressof(last), 10);
+        if (*last != '\0' || options.repeat_ == 0)
+        {
+          return false;
+        }
+      }
+      else if (!options.list_file_)
+      {
+        options.list_file_ = argv[i];
+      }
+      else if (!options.script_file_)
+      {
+        options.script_file_ = argv[i];
+      }
+      else
+      {
+        return false;
+      }
+    }
+    return options.list_file_ && options.script_file_;
+  }
+
+  bool readScript(const char* path, std::vector< std::string >& lines)
+  {
+    std::ifstream in(path);
+    if (!in)
+    {
+      return false;
+    }
+    std::string line;
+    while (std::getline(in, line))
+    {
+      if (!line.empty())
+      {
+        lines.push_back(line);
+      }
+    }
+    return true;
+  }
+
+  long peakResidentKilobytes()
+  {
+    rusage usage {};
+    getrusage(RUSAGE_SELF, std::addressof(usage));
+    return usage.ru_maxrss;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!parseOptions(argc, argv, options))
+  {
+    std::cerr << "Wrong command line params\n";
+    return 1;
+  }
+  std::vector< std::string > script;
+  if (!readScript(options.script_file_, script))
+  {
+    std::cerr << "Script can not be read\n";
+    return 1;
+  }
+  std::string discarded;
+  bendryshev::OutputSink out(discarded);
+  bendryshev::CommandMaker maker(out);
+  bendryshev::Stopwatch load_time;
+  try
+  {
+    if (options.lazy_)
+    {
+      maker.loadListsLazily(options.list_file_);
+    }
+    else
+    {
+      maker.loadLists(options.list_file_);
+    }
+  }
+  catch (const std::system_error&)
+  {
+    std::cerr << "File can not be opened\n";
+    return 1;
+  }
+  std::uint64_t load_nanoseconds = load_time.elapsed();
+  bendryshev::LatencyHistogram latency;
+  bendryshev::Stopwatch total_time;
+  for (unsigned long round = 0; round < options.repeat_; ++round)
+  {
+    for (auto&& line: script)
+    {
+      bendryshev::Stopwatch command_time;
+      maker.doCommand(line);
+      latency.record(command_time.elapsed());
+      discarded.clear();
+    }
+  }
+  out.flush();
+  double seconds = static_cast< double >(total_time.elapsed()) / 1e9;
+  std::uint64_t commands = latency.getCount();
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "{\n";
+  std::cout << "  \"load_seconds\": " << static_cast< double >(load_nanoseconds) / 1e9 << ",\n";
+  std::cout << "  \"commands\": " << commands << ",\n";
+  std::cout << "  \"seconds\": " << seconds << ",\n";
+  std::cout << "  \"commands_per_second\": " << (seconds > 0 ? static_cast< double >(commands) / seconds : 0.0) << ",\n";
+  std::cout << "  \"latency_ns\": { \"p50\": " << latency.percentile(0.5) << ", \"p90\": " << latency.percentile(0.9);
+  std::cout << ", \"p99\": " << latency.percentile(0.99) << ", \"p999\": " << latency.percentile(0.999);
+  std::cout << ", \"max\": " << latency.getMax() << " },\n";
+  std::cout << "  \"peak_rss_kb\": " << peakResidentKilobytes() << "\n";
+  std::cout << "}\n";
+#if S3_COMMAND_STATS
+  if (options.dump_stats_)
+  {
+    bendryshev::OutputSink err(STDERR_FILENO);
+    maker.stats().print(err);
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include "commands/CommandPipeline.h"
+#include <istream>
+#include <utility>
+#include "commands/ListsCommandMaker.h"
+#include "io/Trace.h"
+
+bendryshev::CommandPipeline::CommandPipeline(std::istream& in, std::size_t capacity):
+  in_(in),
+  records_(capacity),
+  reader_(),
+  finished_(false)
+{}
+
+bendryshev::CommandPipeline::~CommandPipeline()
+{
+  CommandRecord record {};
+  while (reader_.joinable() && next(record))
+  {}
+  if (reader_.joinable())
+  {
+    reader_.join();
+  }
+}
+
+void bendryshev::CommandPipeline::start()
+{
+  reader_ = std::thread(&CommandPipeline::read, this);
+}
+
+bool bendryshev::CommandPipeline::next(CommandRecord& record)
+{
+  if (finished_)
+  {
+    return false;
+  }
+  records_.pop(record);
+  finished_ = record.last_;
+  return !finished_;
+}
+
+void bendryshev::CommandPipeline::read()
+{
+  for (;;)
+  {
+    CommandRecord record { std::string(), command_list(), false, false };
+    {
+      S3_TRACE_SPAN("readLine");
+      if (!std::getline(in_, record.line_))
+      {
+        record.last_ = true;
+        records_.push(std::move(record));
+        return;
+      }
+    }
+    if (!record.line_.empty())
+    {
+      record.tokens_ = split(record.line_);
+    }
+    record.drained_ = in_.rdbuf()->in_avail() <= 0;
+    records_.push(std::move(record));
+  }
+}
@@ -0,0 +1,44 @@
+#ifndef S3_COMMANDPIPELINE_H
+#define S3_COMMANDPIPELINE_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include "commands/ListsCommandMaker.h"
+#include "data_structures/BidirectionalList.h"
+#include "data_structures/SpscRing.h"
+
+namespace bendryshev
+{
+  struct CommandRecord
+  {
+    std::string line_;
+    command_list tokens_;
+    bool drained_;
+    bool last_;
+  };
+
+  class CommandPipeline
+  {
+  public:
+    static constexpr std::size_t default_capacity = 1024;
+
+    explicit CommandPipeline(std::istream&, std::size_t capacity = default_capacity);
+    CommandPipeline(const CommandPipeline&) = delete;
+    CommandPipeline& operator=(const CommandPipeline&) = delete;
+    ~CommandPipeline();
+
+    void start();
+    bool next(CommandRecord&);
+  private:
+    std::istream& in_;
+    SpscRing< CommandRecord > records_;
+    std::thread reader_;
+    bool finished_;
+
+    void read();
+  };
+}
+
+#endif
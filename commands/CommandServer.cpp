@@ -0,0 +1,399 @@
+#include "commands/CommandServer.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <system_error>
+#include <utility>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "io/ListParser.h"
+
+namespace
+{
+  constexpr int max_events = 64;
+  constexpr int listen_backlog = 128;
+
+  void throwSystemError(const char* what)
+  {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  int checked(int result, const char* what)
+  {
+    if (result < 0)
+    {
+      throwSystemError(what);
+    }
+    return result;
+  }
+
+  void addToLoop(int epoll_fd, int fd, std::uint32_t events)
+  {
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = fd;
+    checked(::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, std::addressof(event)), "epoll_ctl");
+  }
+
+  int makeSignalFd()
+  {
+    sigset_t signals;
+    sigemptyset(std::addressof(signals));
+    sigaddset(std::addressof(signals), SIGINT);
+    sigaddset(std::addressof(signals), SIGTERM);
+    checked(::pthread_sigmask(SIG_BLOCK, std::addressof(signals), nullptr) == 0 ? 0 : -1, "pthread_sigmask");
+    return checked(::signalfd(-1, std::addressof(signals), SFD_NONBLOCK | SFD_CLOEXEC), "signalfd");
+  }
+}
+
+bendryshev::CommandServer::CommandServer():
+  reply_(),
+  sink_(reply_),
+  maker_(sink_),
+  epoll_fd_(checked(::epoll_create1(EPOLL_CLOEXEC), "epoll_create1")),
+  signal_fd_(-1),
+  listeners_(),
+  unix_path_(),
+  connections_()
+{
+  try
+  {
+    signal_fd_ = makeSignalFd();
+    addToLoop(epoll_fd_, signal_fd_, EPOLLIN);
+  }
+  catch (...)
+  {
+    if (signal_fd_ >= 0)
+    {
+      ::close(signal_fd_);
+    }
+    ::close(epoll_fd_);
+    throw;
+  }
+}
+
+bendryshev::CommandServer::~CommandServer()
+{
+  BidirectionalList< int > fds;
+  for (auto it = connections_.cbegin(); it != connections_.cend(); ++it)
+  {
+    fds.pushBack(it->first);
+  }
+  for (auto&& fd: fds)
+  {
+    close(**connections_.lookup(fd));
+  }
+  for (auto&& fd: listeners_)
+  {
+    ::close(fd);
+  }
+  if (!unix_path_.empty())
+  {
+    ::unlink(unix_path_.c_str());
+  }
+  ::close(signal_fd_);
+  ::close(epoll_fd_);
+}
+
+bendryshev::CommandMaker& bendryshev::CommandServer::maker()
+{
+  return maker_;
+}
+
+void bendryshev::CommandServer::listenUnix(const std::string& path)
+{
+  sockaddr_un address {};
+  if (path.size() >= sizeof(address.sun_path))
+  {
+    throw std::system_error(ENAMETOOLONG, std::generic_category(), path);
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  int fd = checked(::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0), "socket");
+  ::unlink(path.c_str());
+  if (::bind(fd, reinterpret_cast< sockaddr* >(std::addressof(address)), sizeof(address)) != 0)
+  {
+    int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  unix_path_ = path;
+  addListener(fd);
+}
+
+void bendryshev::CommandServer::listenTcp(unsigned short port)
+{
+  sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int fd = checked(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0), "socket");
+  int enable = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, std::addressof(enable), sizeof(enable));
+  if (::bind(fd, reinterpret_cast< sockaddr* >(std::addressof(address)), sizeof(address)) != 0)
+  {
+    int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), "bind");
+  }
+  addListener(fd);
+}
+
+void bendryshev::CommandServer::run()
+{
+  epoll_event events[max_events];
+  for (;;)
+  {
+    int count = ::epoll_wait(epoll_fd_, events, max_events, -1);
+    if (count < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throwSystemError("epoll_wait");
+    }
+    for (int i = 0; i < count; ++i)
+    {
+      int fd = events[i].data.fd;
+      if (fd == signal_fd_)
+      {
+        return;
+      }
+      if (isListener(fd))
+      {
+        accept(fd);
+        continue;
+      }
+      std::unique_ptr< Connection >* found = connections_.lookup(fd);
+      if (!found)
+      {
+        continue;
+      }
+      Connection& connection = **found;
+      if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP))
+      {
+        readFrom(connection);
+      }
+      if (connection.fd_ >= 0 && (events[i].events & EPOLLOUT))
+      {
+        writeTo(connection);
+      }
+      if (connection.fd_ >= 0)
+      {
+        updateInterest(connection);
+      }
+      if (connection.fd_ < 0)
+      {
+        connections_.drop(fd);
+      }
+    }
+  }
+}
+
+bool bendryshev::CommandServer::isListener(int fd) const
+{
+  for (auto it = listeners_.cbegin(); it != listeners_.cend(); ++it)
+  {
+    if (*it == fd)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void bendryshev::CommandServer::addListener(int fd)
+{
+  try
+  {
+    checked(::listen(fd, listen_backlog), "listen");
+    addToLoop(epoll_fd_, fd, EPOLLIN);
+  }
+  catch (...)
+  {
+    ::close(fd);
+    throw;
+  }
+  listeners_.pushBack(fd);
+}
+
+void bendryshev::CommandServer::accept(int listener)
+{
+  for (;;)
+  {
+    int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+      {
+        continue;
+      }
+      return;
+    }
+    try
+    {
+      addToLoop(epoll_fd_, fd, EPOLLIN | EPOLLRDHUP);
+    }
+    catch (const std::system_error&)
+    {
+      ::close(fd);
+      continue;
+    }
+    connections_.drop(fd);
+    connections_.push(fd, std::make_unique< Connection >(Connection { fd, {}, {}, 0, true, false, EPOLLIN | EPOLLRDHUP }));
+  }
+}
+
+void bendryshev::CommandServer::readFrom(Connection& connection)
+{
+  if (!connection.reading_)
+  {
+    return;
+  }
+  bool at_eof = false;
+  char block[read_block];
+  for (;;)
+  {
+    ssize_t received = ::read(connection.fd_, block, sizeof(block));
+    if (received > 0)
+    {
+      connection.in_.append(block, static_cast< std::size_t >(received));
+      if (static_cast< std::size_t >(received) < sizeof(block))
+      {
+        break;
+      }
+    }
+    else if (received == 0)
+    {
+      at_eof = true;
+      break;
+    }
+    else if (errno == EINTR)
+    {
+      continue;
+    }
+    else if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+      break;
+    }
+    else
+    {
+      close(connection);
+      return;
+    }
+  }
+  processLines(connection, at_eof);
+  if (at_eof)
+  {
+    connection.reading_ = false;
+    connection.closing_ = true;
+  }
+  else if (connection.in_.size() > max_line_length)
+  {
+    close(connection);
+    return;
+  }
+  writeTo(connection);
+}
+
+void bendryshev::CommandServer::processLines(Connection& connection, bool at_eof)
+{
+  const char* first = connection.in_.data();
+  const char* last = first + connection.in_.size();
+  const char* current = first;
+  while (current != last)
+  {
+    const char* line_end = findLineEnd(current, last);
+    if (line_end == last && !at_eof)
+    {
+      break;
+    }
+    if (line_end != current)
+    {
+      maker_.doCommand(std::string(current, line_end));
+    }
+    current = (line_end == last) ? last : line_end + 1;
+  }
+  connection.in_.erase(0, static_cast< std::size_t >(current - first));
+  maker_.flush();
+  if (connection.out_offset_ == connection.out_.size())
+  {
+    connection.out_.clear();
+    connection.out_offset_ = 0;
+  }
+  connection.out_.append(reply_);
+  reply_.clear();
+}
+
+void bendryshev::CommandServer::writeTo(Connection& connection)
+{
+  while (connection.out_offset_ < connection.out_.size())
+  {
+    const char* data = connection.out_.data() + connection.out_offset_;
+    std::size_t length = connection.out_.size() - connection.out_offset_;
+    ssize_t sent = ::send(connection.fd_, data, length, MSG_NOSIGNAL);
+    if (sent >= 0)
+    {
+      connection.out_offset_ += static_cast< std::size_t >(sent);
+    }
+    else if (errno == EINTR)
+    {
+      continue;
+    }
+    else if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+      return;
+    }
+    else
+    {
+      close(connection);
+      return;
+    }
+  }
+  connection.out_.clear();
+  connection.out_offset_ = 0;
+  if (connection.closing_)
+  {
+    close(connection);
+  }
+}
+
+void bendryshev::CommandServer::updateInterest(Connection& connection)
+{
+  bool backlogged = connection.out_.size() - connection.out_offset_ > max_pending_output;
+  connection.reading_ = !connection.closing_ && !backlogged;
+  bool writable_wanted = connection.out_offset_ < connection.out_.size();
+  std::uint32_t events = 0;
+  if (connection.reading_)
+  {
+    events |= EPOLLIN | EPOLLRDHUP;
+  }
+  if (writable_wanted)
+  {
+    events |= EPOLLOUT;
+  }
+  if (events != connection.events_)
+  {
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = connection.fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd_, std::addressof(event));
+    connection.events_ = events;
+  }
+}
+
+void bendryshev::CommandServer::close(Connection& connection)
+{
+  if (connection.fd_ >= 0)
+  {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection.fd_, nullptr);
+    ::close(connection.fd_);
+    connection.fd_ = -1;
+  }
+}
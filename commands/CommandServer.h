@@ -0,0 +1,64 @@
+#ifndef S3_COMMANDSERVER_H
+#define S3_COMMANDSERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "commands/ListsCommandMaker.h"
+#include "data_structures/BidirectionalList.h"
+#include "data_structures/TreeDictionary.h"
+#include "io/OutputSink.h"
+
+namespace bendryshev
+{
+  class CommandServer
+  {
+  public:
+    CommandServer();
+    CommandServer(const CommandServer&) = delete;
+    CommandServer& operator=(const CommandServer&) = delete;
+    ~CommandServer();
+
+    CommandMaker& maker();
+    void listenUnix(const std::string&);
+    void listenTcp(unsigned short port);
+    void run();
+  private:
+    static constexpr std::size_t read_block = 1 << 16;
+    static constexpr std::size_t max_pending_output = 1 << 22;
+    static constexpr std::size_t max_line_length = 1 << 26;
+
+    struct Connection
+    {
+      int fd_;
+      std::string in_;
+      std::string out_;
+      std::size_t out_offset_;
+      bool reading_;
+      bool closing_;
+      std::uint32_t events_;
+    };
+    using connection_dict = TreeDictionary< int, std::unique_ptr< Connection >, std::less< > >;
+
+    std::string reply_;
+    OutputSink sink_;
+    CommandMaker maker_;
+    int epoll_fd_;
+    int signal_fd_;
+    BidirectionalList< int > listeners_;
+    std::string unix_path_;
+    connection_dict connections_;
+
+    bool isListener(int) const;
+    void addListener(int);
+    void accept(int);
+    void readFrom(Connection&);
+    void processLines(Connection&, bool at_eof);
+    void writeTo(Connection&);
+    void updateInterest(Connection&);
+    void close(Connection&);
+  };
+}
+
+#endif
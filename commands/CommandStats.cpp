@@ -0,0 +1,192 @@
+#include "commands/CommandStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  void accumulate(bendryshev::PerfSample& total, const bendryshev::PerfSample& sample) noexcept
+  {
+    for (std::size_t i = 0; i < bendryshev::perf::event_count; ++i)
+    {
+      if (sample.has(i))
+      {
+        total.values_[i] += sample.values_[i];
+      }
+    }
+    total.mask_ |= sample.mask_;
+  }
+
+  void printEvents(bendryshev::OutputSink& out, const bendryshev::CommandCounters& item)
+  {
+    const bendryshev::PerfSample& events = item.events_;
+    for (std::size_t i = 0; i < bendryshev::perf::event_count; ++i)
+    {
+      if (events.has(i))
+      {
+        out << ' ' << bendryshev::perf::eventName(i) << ' ' << static_cast< unsigned long >(events.values_[i]);
+      }
+    }
+    using bendryshev::perf::cycles;
+    using bendryshev::perf::instructions;
+    if (events.has(cycles) && events.has(instructions) && events.values_[cycles] != 0)
+    {
+      unsigned long ipc = static_cast< unsigned long >(events.values_[instructions] * 100 / events.values_[cycles]);
+      out << " ipc " << ipc / 100 << '.' << static_cast< char >('0' + ipc / 10 % 10) << static_cast< char >('0' + ipc % 10);
+    }
+    out << " sampled " << item.sampled_;
+  }
+}
+
+bendryshev::LatencyHistogram::LatencyHistogram() noexcept:
+  buckets_(),
+  count_(0),
+  max_(0)
+{}
+
+std::size_t bendryshev::LatencyHistogram::bucketOf(std::uint64_t value) noexcept
+{
+  if (value < sub_buckets)
+  {
+    return static_cast< std::size_t >(value);
+  }
+  unsigned exponent = 63 - static_cast< unsigned >(__builtin_clzll(value));
+  if (exponent > max_exponent)
+  {
+    return bucket_count - 1;
+  }
+  unsigned shift = exponent - sub_bucket_bits;
+  std::size_t sub_bucket = static_cast< std::size_t >((value >> shift) & (sub_buckets - 1));
+  return (shift + 1) * sub_buckets + sub_bucket;
+}
+
+std::uint64_t bendryshev::LatencyHistogram::upperBoundOf(std::size_t bucket) noexcept
+{
+  if (bucket < sub_buckets)
+  {
+    return bucket;
+  }
+  unsigned shift = static_cast< unsigned >(bucket / sub_buckets - 1);
+  std::uint64_t lower = static_cast< std::uint64_t >(sub_buckets + bucket % sub_buckets) << shift;
+  return lower + (std::uint64_t(1) << shift) - 1;
+}
+
+void bendryshev::LatencyHistogram::record(std::uint64_t value) noexcept
+{
+  ++buckets_[bucketOf(value)];
+  ++count_;
+  max_ = std::max(max_, value);
+}
+
+void bendryshev::LatencyHistogram::merge(const LatencyHistogram& rhs) noexcept
+{
+  for (std::size_t i = 0; i < bucket_count; ++i)
+  {
+    buckets_[i] += rhs.buckets_[i];
+  }
+  count_ += rhs.count_;
+  max_ = std::max(max_, rhs.max_);
+}
+
+std::uint64_t bendryshev::LatencyHistogram::getCount() const noexcept
+{
+  return count_;
+}
+
+std::uint64_t bendryshev::LatencyHistogram::getMax() const noexcept
+{
+  return max_;
+}
+
+std::uint64_t bendryshev::LatencyHistogram::percentile(double quantile) const noexcept
+{
+  if (count_ == 0)
+  {
+    return 0;
+  }
+  std::uint64_t target = static_cast< std::uint64_t >(std::ceil(quantile * static_cast< double >(count_)));
+  target = std::max< std::uint64_t >(target, 1);
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < bucket_count; ++i)
+  {
+    seen += buckets_[i];
+    if (seen >= target)
+    {
+      return std::min(upperBoundOf(i), max_);
+    }
+  }
+  return max_;
+}
+
+void bendryshev::CommandCounters::record(std::uint64_t nanoseconds, bool failed, unsigned long touched) noexcept
+{
+  ++calls_;
+  failures_ += failed ? 1 : 0;
+  touched_ += touched;
+  latency_.record(nanoseconds);
+}
+
+void bendryshev::CommandCounters::record(const PerfSample& sample) noexcept
+{
+  accumulate(events_, sample);
+  ++sampled_;
+}
+
+void bendryshev::CommandCounters::record(const accounting::Counts& memory) noexcept
+{
+  memory_.allocations_ += memory.allocations_;
+  memory_.frees_ += memory.frees_;
+  memory_.bytes_ += memory.bytes_;
+  memory_.hops_ += memory.hops_;
+}
+
+void bendryshev::CommandCounters::merge(const CommandCounters& rhs) noexcept
+{
+  calls_ += rhs.calls_;
+  failures_ += rhs.failures_;
+  touched_ += rhs.touched_;
+  latency_.merge(rhs.latency_);
+  accumulate(events_, rhs.events_);
+  sampled_ += rhs.sampled_;
+  record(rhs.memory_);
+}
+
+bendryshev::CommandCounters& bendryshev::CommandStats::counters(const std::string& keyword)
+{
+  CommandCounters* found = commands_.lookup(keyword);
+  if (!found)
+  {
+    commands_.push(keyword, CommandCounters { 0, 0, 0, LatencyHistogram(), PerfSample {}, 0, accounting::Counts {} });
+    found = commands_.lookup(keyword);
+  }
+  return *found;
+}
+
+void bendryshev::CommandStats::merge(const CommandStats& rhs)
+{
+  for (auto it = rhs.commands_.cbegin(); it != rhs.commands_.cend(); ++it)
+  {
+    counters(it->first).merge(it->second);
+  }
+}
+
+void bendryshev::CommandStats::print(OutputSink& out) const
+{
+  for (auto it = commands_.cbegin(); it != commands_.cend(); ++it)
+  {
+    const CommandCounters& item = it->second;
+    out << it->first << " calls " << item.calls_ << " failures " << item.failures_;
+    out << " touched " << item.touched_;
+    out << " p50 " << static_cast< unsigned long >(item.latency_.percentile(0.5)) << "ns";
+    out << " p99 " << static_cast< unsigned long >(item.latency_.percentile(0.99)) << "ns";
+    out << " max " << static_cast< unsigned long >(item.latency_.getMax()) << "ns";
+#if S3_CONTAINER_ACCOUNTING
+    out << " allocs " << item.memory_.allocations_ << " frees " << item.memory_.frees_;
+    out << " bytes " << item.memory_.bytes_ << " hops " << item.memory_.hops_;
+#endif
+    if (item.sampled_ != 0)
+    {
+      printEvents(out, item);
+    }
+    out << '\n';
+  }
+}
@@ -0,0 +1,84 @@
+#ifndef S3_COMMANDSTATS_H
+#define S3_COMMANDSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "data_structures/ContainerAccounting.h"
+#include "data_structures/TreeDictionary.h"
+#include "io/OutputSink.h"
+#include "io/PerfCounters.h"
+
+#ifndef S3_COMMAND_STATS
+#define S3_COMMAND_STATS 1
+#endif
+
+namespace bendryshev
+{
+  class LatencyHistogram
+  {
+  public:
+    LatencyHistogram() noexcept;
+
+    void record(std::uint64_t) noexcept;
+    void merge(const LatencyHistogram&) noexcept;
+    std::uint64_t getCount() const noexcept;
+    std::uint64_t getMax() const noexcept;
+    std::uint64_t percentile(double) const noexcept;
+  private:
+    static constexpr unsigned sub_bucket_bits = 4;
+    static constexpr unsigned sub_buckets = 1u << sub_bucket_bits;
+    static constexpr unsigned max_exponent = 40;
+    static constexpr std::size_t bucket_count = sub_buckets * (max_exponent - sub_bucket_bits + 2);
+
+    std::uint64_t buckets_[bucket_count];
+    std::uint64_t count_;
+    std::uint64_t max_;
+
+    static std::size_t bucketOf(std::uint64_t) noexcept;
+    static std::uint64_t upperBoundOf(std::size_t) noexcept;
+  };
+
+  struct CommandCounters
+  {
+    unsigned long calls_;
+    unsigned long failures_;
+    unsigned long touched_;
+    LatencyHistogram latency_;
+    PerfSample events_;
+    unsigned long sampled_;
+    accounting::Counts memory_;
+
+    void record(std::uint64_t nanoseconds, bool failed, unsigned long touched) noexcept;
+    void record(const PerfSample&) noexcept;
+    void record(const accounting::Counts&) noexcept;
+    void merge(const CommandCounters&) noexcept;
+  };
+
+  class CommandStats
+  {
+  public:
+    CommandCounters& counters(const std::string&);
+    void merge(const CommandStats&);
+    void print(OutputSink&) const;
+  private:
+    TreeDictionary< std::string, CommandCounters, std::less< > > commands_;
+  };
+
+  namespace stats
+  {
+#if S3_COMMAND_STATS
+    inline thread_local unsigned long touched_elements = 0;
+
+    inline void touch(unsigned long count) noexcept
+    {
+      touched_elements += count;
+    }
+#else
+    inline void touch(unsigned long) noexcept
+    {}
+#endif
+  }
+}
+
+#endif
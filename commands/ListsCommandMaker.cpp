@@ -1,516 +1,1817 @@
-#include "commands/ListsCommandMaker.h"
-#include <iostream>
-#include <algorithm>
-#include "printCommandMessages.h"
-
-bendryshev::BidirectionalList< std::string > bendryshev::readListFromStream(std::istream& in)
-{
-  bendryshev::BidirectionalList< std::string > input_data;
-  std::string temp;
-  while (std::getline(in, temp))
-  {
-    if (temp.empty())
-    {
-      continue;
-    }
-    else
-    {
-      input_data.pushBack(temp);
-    }
-  }
-  return input_data;
-}
-
-bendryshev::BidirectionalList< std::string > bendryshev::split(const std::string& data)
-{
-  bendryshev::BidirectionalList< std::string > string_parts;
-  size_t last_space = 0;
-  while (last_space < data.length())
-  {
-    size_t next_space = data.find_first_of(' ', last_space + 1);
-    next_space = (next_space == std::string::npos) ? data.size() : next_space;
-    std::string word = data.substr(last_space, next_space - last_space);
-
-    string_parts.pushBack(word);
-    last_space = next_space + 1;
-  }
-  return string_parts;
-}
-
-namespace
-{
-  using cmd_it = bendryshev::CommandMaker::command_list_iterator;
-  using pos = bendryshev::CommandMaker::pos;
-
-  bool isEqualRange(const pos& pos1, const pos& pos2, const pos& pos3, const pos& pos4)
-  {
-    return (pos2.index_ - pos1.index_ == pos4.index_ - pos3.index_);
-  }
-
-  void checkEndOfCommand(cmd_it begin, cmd_it end)
-  {
-    if (begin == end)
-    {
-      throw std::logic_error("end of command");
-    }
-  }
-
-  void setPosName(cmd_it& begin, std::string& pos_name)
-  {
-    pos_name = *(begin++);
-  }
-
-  void checkListPresence(bendryshev::CommandMaker::list_dict& lists_dict, const std::string& name)
-  {
-    if (lists_dict.find(name) == lists_dict.end())
-    {
-      throw std::logic_error("no list in dict");
-    }
-  }
-
-  void checkPosPresence(bendryshev::CommandMaker::pos_dict& pos_dict, const std::string& name)
-  {
-    if (pos_dict.find(name) == pos_dict.end())
-    {
-      throw std::logic_error("no pos in dict");
-    }
-  }
-
-  void checkExistedPos(bendryshev::CommandMaker::pos_dict& pos_dict, cmd_it& begin, std::string& pos_name)
-  {
-    setPosName(begin, pos_name);
-    checkPosPresence(pos_dict, pos_name);
-  }
-
-  using value_t = bendryshev::CommandMaker::value_t;
-
-  bool isNumber(const std::string& str)
-  {
-    return std::all_of(str.begin(), str.end(), isdigit);
-  }
-
-  void replace(bendryshev::CommandMaker::list& list, value_t value1, value_t value2)
-  {
-    for (auto&& item: list)
-    {
-      if (item == value1)
-      {
-        item = value2;
-      }
-    }
-  }
-
-  void replace(bendryshev::CommandMaker::list& dest_list, value_t value, bendryshev::CommandMaker::list& arg_list)
-  {
-    while (dest_list.find(value) != dest_list.end())
-    {
-      auto it = dest_list.find(value);
-      for (auto&& item: arg_list)
-      {
-        dest_list.emplace(it, item);
-      }
-      dest_list.erase(it);
-    }
-  }
-
-  void remove(bendryshev::CommandMaker::list& list, value_t value)
-  {
-    auto it = list.begin();
-    while (it != list.end())
-    {
-      if (*it == value)
-      {
-        list.erase(it++);
-      }
-      else
-      {
-        it++;
-      }
-    }
-  }
-
-  void remove(bendryshev::CommandMaker::list& list, bendryshev::CommandMaker::list& value_list)
-  {
-    for (auto&& value: value_list)
-    {
-      while (list.find(value) != list.end())
-      {
-        auto it = list.find(value);
-        list.erase(it);
-      }
-    }
-  }
-
-  void pushBack(bendryshev::CommandMaker::list& list1, bendryshev::CommandMaker::list& list2)
-  {
-    for (auto&& item: list2)
-    {
-      list1.pushBack(item);
-    }
-  }
-}
-
-bendryshev::CommandMaker::CommandMaker(std::ostream& out):
-  out_(out),
-  lists_(),
-  command_dictionary_(
-   {
-     { "print",    std::bind(&CommandMaker::doPrintCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "replace",  std::bind(&CommandMaker::doReplaceCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "remove",   std::bind(&CommandMaker::doRemoveCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "concat",   std::bind(&CommandMaker::doConcatCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "equal",    std::bind(&CommandMaker::doEqualCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "begin",    std::bind(&CommandMaker::doBeginCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "end",      std::bind(&CommandMaker::doEndCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "mismatch", std::bind(&CommandMaker::doMismatchCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "printPos", std::bind(&CommandMaker::doPrintPosCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "swap",     std::bind(&CommandMaker::doSwapCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "find",     std::bind(&CommandMaker::doFindCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "rotate",   std::bind(&CommandMaker::doRotateCommand, this, std::placeholders::_1, std::placeholders::_2) },
-     { "search",   std::bind(&CommandMaker::doSearchCommand, this, std::placeholders::_1, std::placeholders::_2) }
-   })
-{}
-
-void bendryshev::CommandMaker::readLists(std::istream& in)
-{
-  bendryshev::BidirectionalList< std::string > input_data = readListFromStream(in);
-  for (auto&& item: input_data)
-  {
-    bendryshev::BidirectionalList< std::string > string_parts = split(item);
-    if (!string_parts.isEmpty())
-    {
-      auto begin = string_parts.begin();
-      auto end = string_parts.end();
-      std::string new_list_name = *(begin++);
-      list new_list;
-      while (begin != end)
-      {
-        bendryshev::CommandMaker::value_t value = std::stoi(*(begin++));
-        new_list.pushBack(value);
-      }
-      lists_.push(new_list_name, new_list);
-    }
-  }
-}
-
-void bendryshev::CommandMaker::doCommand(bendryshev::BidirectionalList< bendryshev::CommandMaker::command >& commandList)
-{
-  assert(!commandList.isEmpty());
-  try
-  {
-    bendryshev::CommandMaker::command_list_iterator commandList_Iterator_begin = commandList.begin();
-    bendryshev::CommandMaker::command_list_iterator commandList_Iterator_end = commandList.end();
-    bendryshev::CommandMaker::command target = *commandList_Iterator_begin;
-    if (command_dictionary_.find(target) != command_dictionary_.end())
-    {
-      command_dictionary_.get(target)(++commandList_Iterator_begin, commandList_Iterator_end);
-    }
-    else
-    {
-      bendryshev::printInvalidCommandMessage(out_);
-    }
-  }
-  catch (const std::logic_error&)
-  {
-    bendryshev::printInvalidCommandMessage(out_);
-  }
-}
-
-void bendryshev::CommandMaker::doPrintCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  checkListPresence(lists_, list_name);
-  if (begin == end)
-  {
-    list& new_list = lists_.get(list_name);
-    if (new_list.isEmpty())
-    {
-      bendryshev::printEmptyCommandMessage(out_);
-    }
-    else
-    {
-      out_ << list_name;
-      for (auto&& item: new_list)
-      {
-        out_ << " " << item;
-      }
-      out_ << "\n";
-    }
-  }
-  else
-  {
-    throw std::logic_error("");
-  }
-}
-
-
-void bendryshev::CommandMaker::doReplaceCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  checkListPresence(lists_, list_name);
-  list& dest_list = lists_.get(list_name);
-  checkEndOfCommand(begin, end);
-  value_t first_value = std::stoi(*(begin++));
-  checkEndOfCommand(begin, end);
-  std::string next_part = *(begin++);
-  if (isNumber(next_part))
-  {
-    value_t next_value = std::stoi(next_part);
-    replace(dest_list, first_value, next_value);
-  }
-  else
-  {
-    checkListPresence(lists_, next_part);
-    list& second_list = lists_.get(next_part);
-    replace(dest_list, first_value, second_list);
-  }
-}
-
-void bendryshev::CommandMaker::doRemoveCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  checkEndOfCommand(begin, end);
-  checkListPresence(lists_, list_name);
-  list& dest_list = lists_.get(list_name);
-  std::string next_part = *(begin++);
-  if (isNumber(next_part))
-  {
-    value_t value_to_delete = std::stoi(next_part);
-    remove(dest_list, value_to_delete);
-  }
-  else
-  {
-    checkListPresence(lists_, next_part);
-    list& new_list = lists_.get(next_part);
-    remove(dest_list, new_list);
-  }
-}
-
-void bendryshev::CommandMaker::doConcatCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  list concat_list;
-  checkEndOfCommand(begin, end);
-  std::string dest_list_name = *(begin++);
-  checkListPresence(lists_, dest_list_name);
-  list& dest_list = lists_.get(dest_list_name);
-  pushBack(concat_list, dest_list);
-  checkEndOfCommand(begin, end);
-  while (begin != end)
-  {
-    std::string new_list_name = *(begin++);
-    checkListPresence(lists_, new_list_name);
-    list& new_list = lists_.get(new_list_name);
-    pushBack(concat_list, new_list);
-  }
-  lists_.drop(list_name);
-  lists_.push(list_name, concat_list);
-}
-
-void bendryshev::CommandMaker::doEqualCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string first_list_name = *(begin++);
-  checkListPresence(lists_, first_list_name);
-  list& first_list = lists_.get(first_list_name);
-  checkEndOfCommand(begin, end);
-  std::string second_list_name = *(begin++);
-  checkListPresence(lists_, second_list_name);
-  list& second_list = lists_.get(second_list_name);
-  bool is_equal = first_list == second_list;
-  while (begin != end && is_equal)
-  {
-    std::string new_list_name = *(begin++);
-    checkListPresence(lists_, new_list_name);
-    is_equal = (first_list == lists_.get(new_list_name));
-  }
-  if (is_equal)
-  {
-    bendryshev::printTrueMessage(out_);
-  }
-  else
-  {
-    bendryshev::printFalseMessage(out_);
-  }
-}
-
-void bendryshev::CommandMaker::doBeginCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos_name;
-  setPosName(begin, pos_name);
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  checkListPresence(lists_, list_name);
-  list& list = lists_.get(list_name);
-  pos new_pos = { 0, list, list.begin() };
-  positions_.drop(pos_name);
-  positions_.push(pos_name, new_pos);
-}
-
-void bendryshev::CommandMaker::doEndCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos_name;
-  setPosName(begin, pos_name);
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  checkListPresence(lists_, list_name);
-  list& list = lists_.get(list_name);
-  pos new_pos { static_cast< value_t >(list.getSize()), list, list.end() };
-  positions_.drop(pos_name);
-  positions_.push(pos_name, new_pos);
-}
-
-void bendryshev::CommandMaker::doMismatchCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos_name;
-  setPosName(begin, pos_name);
-  checkEndOfCommand(begin, end);
-  std::string list1_name = *(begin++);
-  checkEndOfCommand(begin, end);
-  checkListPresence(lists_, list1_name);
-  list& list1 = lists_.get(list1_name);
-  std::string list2_name = *(begin++);
-  checkListPresence(lists_, list2_name);
-  list& list2 = lists_.get(list2_name);
-  value_t count = 0;
-  auto it1 = list1.begin();
-  auto it2 = list2.begin();
-  while (it1 != list1.end() && it2 != list2.end())
-  {
-    if (*it1 != *it2)
-    {
-      break;
-    }
-    ++count;
-    ++it1;
-    ++it2;
-  }
-  pos new_pos = { count, list1, it1 };
-  positions_.drop(pos_name);
-  positions_.push(pos_name, new_pos);
-}
-
-void bendryshev::CommandMaker::doPrintPosCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos_name;
-  checkExistedPos(positions_, begin, pos_name);
-  if (begin == end)
-  {
-    pos new_pos = positions_.get(pos_name);
-    out_ << pos_name << " ";
-    out_ << new_pos.index_ << "\n";
-  }
-  else
-  {
-    throw std::logic_error("");
-  }
-}
-
-void bendryshev::CommandMaker::doSwapCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos1_name;
-  checkExistedPos(positions_, begin, pos1_name);
-  auto& pos1 = positions_.get(pos1_name);
-  checkEndOfCommand(begin, end);
-  std::string pos2_name;
-  checkExistedPos(positions_, begin, pos2_name);
-  auto& pos2 = positions_.get(pos2_name);
-  std::swap(pos1, pos2);
-}
-
-void bendryshev::CommandMaker::doFindCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos_name;
-  setPosName(begin, pos_name);
-  checkEndOfCommand(begin, end);
-  std::string list_name = *(begin++);
-  checkListPresence(lists_, list_name);
-  list list = lists_.get(list_name);
-  checkEndOfCommand(begin, end);
-  value_t elem = std::stoi(*(begin++));
-  value_t count = 0;
-  auto it = list.begin();
-  while (it != list.find(elem))
-  {
-    ++count;
-    ++it;
-  }
-  positions_.drop(pos_name);
-  positions_.push(pos_name, { count, list, it });
-}
-
-void bendryshev::CommandMaker::doRotateCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos1_name;
-  checkExistedPos(positions_, begin, pos1_name);
-  checkEndOfCommand(begin,end);
-  std::string pos2_name;
-  checkExistedPos(positions_, begin, pos2_name);
-  checkEndOfCommand(begin,end);
-  std::string pos3_name;
-  checkExistedPos(positions_, begin, pos3_name);
-  checkEndOfCommand(begin,end);
-  std::string pos4_name;
-  checkExistedPos(positions_, begin, pos4_name);
-  auto pos1 = positions_.get(pos1_name);
-  auto pos2 = positions_.get(pos2_name);
-  auto pos3 = positions_.get(pos3_name);
-  auto pos4 = positions_.get(pos4_name);
-  if (!isEqualRange(pos1, pos2, pos3, pos4))
-  {
-    throw std::logic_error("");
-  }
-  auto iter1 = pos1.iter_;
-  auto iter2 = pos3.iter_;
-  while (iter1 != pos2.iter_)
-  {
-    std::iter_swap(iter1, iter2);
-    ++iter1;
-    ++iter2;
-  }
-}
-
-void bendryshev::CommandMaker::doSearchCommand(command_list_iterator begin, command_list_iterator end)
-{
-  checkEndOfCommand(begin, end);
-  std::string pos_name;
-  setPosName(begin, pos_name);
-  checkEndOfCommand(begin, end);
-  std::string pos1_name;
-  checkExistedPos(positions_, begin, pos1_name);
-  checkEndOfCommand(begin, end);
-  std::string pos2_name;
-  checkExistedPos(positions_, begin, pos2_name);
-  auto pos1 = positions_.get(pos1_name);
-  auto pos2 = positions_.get(pos2_name);
-  if (pos1.list_ != pos2.list_)
-  {
-    throw std::logic_error("");
-  }
-  value_t elem = std::stoi(*(begin++));
-  value_t count = pos1.index_;
-  auto it = pos1.iter_;
-  while (it != pos2.iter_)
-  {
-    if (*it == elem)
-    {
-      break;
-    }
-    ++count;
-    ++it;
-  }
-  positions_.drop(pos_name);
-  positions_.push(pos_name, { count, pos1.list_, it });
-}
-
+#include "commands/ListsCommandMaker.h"
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <unistd.h>
+#include "printCommandMessages.h"
+#include "io/ListParser.h"
+#include "io/ListFileLoader.h"
+#include "io/MappedFile.h"
+#include "io/Snapshot.h"
+#include "io/Trace.h"
+
+bendryshev::BidirectionalList< std::string > bendryshev::readListFromStream(std::istream& in)
+{
+  bendryshev::BidirectionalList< std::string > input_data;
+  std::string temp;
+  while (std::getline(in, temp))
+  {
+    if (temp.empty())
+    {
+      continue;
+    }
+    else
+    {
+      input_data.pushBack(temp);
+    }
+  }
+  return input_data;
+}
+
+bendryshev::command_list bendryshev::split(const std::string& data, std::pmr::memory_resource* memory)
+{
+  S3_TRACE_SPAN("split");
+  bendryshev::command_list string_parts(memory);
+  size_t last_space = 0;
+  while (last_space < data.length())
+  {
+    size_t next_space = data.find_first_of(' ', last_space + 1);
+    next_space = (next_space == std::string::npos) ? data.size() : next_space;
+    string_parts.pushBack(data.substr(last_space, next_space - last_space));
+    last_space = next_space + 1;
+  }
+  return string_parts;
+}
+
+namespace
+{
+  using cmd_it = bendryshev::CommandMaker::command_list_iterator;
+  using pos = bendryshev::CommandMaker::pos;
+
+  bool isEqualRange(const pos& pos1, const pos& pos2, const pos& pos3, const pos& pos4)
+  {
+    return (pos2.index_ - pos1.index_ == pos4.index_ - pos3.index_);
+  }
+
+  void checkEndOfCommand(cmd_it begin, cmd_it end)
+  {
+    if (begin == end)
+    {
+      throw std::logic_error("end of command");
+    }
+  }
+
+  using value_t = bendryshev::CommandMaker::value_t;
+  using fingerprint = bendryshev::CommandMaker::fingerprint;
+
+  unsigned long nextGeneration()
+  {
+    // Shared by every shard, so a generation moved along with its list never collides with one issued elsewhere.
+    static std::atomic< unsigned long > generation(0);
+    return ++generation;
+  }
+
+  fingerprint replace(bendryshev::CommandMaker::list& list, value_t value1, value_t value2)
+  {
+    S3_TRACE_SPAN("replace.scan");
+    fingerprint result;
+    for (auto&& item: list)
+    {
+      if (item == value1)
+      {
+        item = value2;
+      }
+      result.append(item);
+    }
+    bendryshev::stats::touch(result.getSize());
+    return result;
+  }
+
+  template< typename List >
+  fingerprint replace(bendryshev::CommandMaker::list& dest_list, value_t value, const List& arg_list, bendryshev::ScratchArena& scratch)
+  {
+    S3_TRACE_SPAN("replace.scan");
+    const bendryshev::CommandMaker::scratch_list replacement(arg_list.cbegin(), arg_list.cend(), scratch.resource());
+    const fingerprint replacement_print = fingerprint::of(replacement);
+    fingerprint result;
+    unsigned long scanned = 0;
+    auto it = dest_list.begin();
+    while (it != dest_list.end())
+    {
+      ++scanned;
+      if (*it == value)
+      {
+        bendryshev::CommandMaker::list copy(replacement.cbegin(), replacement.cend());
+        dest_list.splice(it, copy);
+        it = dest_list.erase(it);
+        result.append(replacement_print);
+      }
+      else
+      {
+        result.append(*it);
+        ++it;
+      }
+    }
+    bendryshev::stats::touch(scanned);
+    return result;
+  }
+
+  fingerprint remove(bendryshev::CommandMaker::list& list, value_t value)
+  {
+    S3_TRACE_SPAN("remove.scan");
+    fingerprint result;
+    unsigned long scanned = 0;
+    auto it = list.begin();
+    while (it != list.end())
+    {
+      ++scanned;
+      if (*it == value)
+      {
+        list.erase(it++);
+      }
+      else
+      {
+        result.append(*(it++));
+      }
+    }
+    bendryshev::stats::touch(scanned);
+    return result;
+  }
+
+  class ValueFilter
+  {
+  public:
+    template< typename List >
+    ValueFilter(const List& values, std::pmr::memory_resource* scratch):
+      count_(0),
+      min_(0),
+      max_(0),
+      allocated_(0),
+      range_(0),
+      scratch_(scratch),
+      values_(nullptr),
+      bitmap_(nullptr)
+    {
+      for (auto it = values.cbegin(); it != values.cend(); ++it)
+      {
+        ++count_;
+      }
+      allocated_ = count_;
+      values_ = scratch_.allocate(allocated_);
+      value_t* out = values_;
+      for (auto it = values.cbegin(); it != values.cend(); ++it)
+      {
+        *(out++) = *it;
+      }
+      std::sort(values_, values_ + count_);
+      count_ = static_cast< std::size_t >(std::unique(values_, values_ + count_) - values_);
+      if (count_ == 0)
+      {
+        return;
+      }
+      min_ = values_[0];
+      max_ = values_[count_ - 1];
+      long long range = static_cast< long long >(max_) - min_ + 1;
+      if (range <= max_bitmap_size)
+      {
+        range_ = static_cast< std::size_t >(range);
+        bitmap_ = std::pmr::polymorphic_allocator< bool >(scratch_).allocate(range_);
+        std::fill(bitmap_, bitmap_ + range_, false);
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+          bitmap_[values_[i] - min_] = true;
+        }
+      }
+    }
+
+    ValueFilter(const ValueFilter&) = delete;
+    ValueFilter& operator=(const ValueFilter&) = delete;
+
+    ~ValueFilter()
+    {
+      if (bitmap_)
+      {
+        std::pmr::polymorphic_allocator< bool >(scratch_).deallocate(bitmap_, range_);
+      }
+      scratch_.deallocate(values_, allocated_);
+    }
+
+    bool isEmpty() const noexcept
+    {
+      return count_ == 0;
+    }
+
+    bool contains(value_t value) const
+    {
+      if (count_ == 0 || value < min_ || value > max_)
+      {
+        return false;
+      }
+      if (bitmap_)
+      {
+        return bitmap_[static_cast< long long >(value) - min_];
+      }
+      return std::binary_search(values_, values_ + count_, value);
+    }
+  private:
+    static constexpr long long max_bitmap_size = 1 << 16;
+
+    std::size_t count_;
+    value_t min_;
+    value_t max_;
+    std::size_t allocated_;
+    std::size_t range_;
+    std::pmr::polymorphic_allocator< value_t > scratch_;
+    value_t* values_;
+    bool* bitmap_;
+  };
+
+  template< typename List >
+  fingerprint remove(bendryshev::CommandMaker::list& list, const List& value_list, bendryshev::ScratchArena& scratch)
+  {
+    S3_TRACE_SPAN("remove.scan");
+    const ValueFilter filter(value_list, scratch.resource());
+    if (filter.isEmpty())
+    {
+      return fingerprint::of(list);
+    }
+    fingerprint result;
+    unsigned long scanned = 0;
+    auto it = list.begin();
+    while (it != list.end())
+    {
+      ++scanned;
+      if (filter.contains(*it))
+      {
+        it = list.erase(it);
+      }
+      else
+      {
+        result.append(*(it++));
+      }
+    }
+    bendryshev::stats::touch(scanned);
+    return result;
+  }
+
+  template< typename List >
+  void pushBack(bendryshev::CommandMaker::list& list1, const List& list2)
+  {
+    S3_TRACE_SPAN("concat.copy");
+    unsigned long copied = 0;
+    for (auto it = list2.cbegin(); it != list2.cend(); ++it, ++copied)
+    {
+      list1.pushBack(*it);
+    }
+    bendryshev::stats::touch(copied);
+  }
+
+  void appendSegment(bendryshev::CommandMaker::concat_list& dest, const bendryshev::CommandMaker::list& source)
+  {
+    dest.append(source);
+  }
+
+  void appendSegment(bendryshev::CommandMaker::concat_list& dest, const bendryshev::CommandMaker::concat_list& source)
+  {
+    dest.append(source);
+  }
+
+  void appendSegment(bendryshev::CommandMaker::concat_list& dest, const bendryshev::CommandMaker::mapped_list& source)
+  {
+    dest.append(source.data(), source.data() + source.getSize());
+  }
+
+  template< typename List1, typename List2 >
+  bool isEqual(const List1& list1, const List2& list2)
+  {
+    S3_TRACE_SPAN("equal.scan");
+    unsigned long compared = 0;
+    auto it1 = list1.cbegin();
+    auto it2 = list2.cbegin();
+    while (it1 != list1.cend() && it2 != list2.cend() && *it1 == *it2)
+    {
+      ++compared;
+      ++it1;
+      ++it2;
+    }
+    bendryshev::stats::touch(compared);
+    return it1 == list1.cend() && it2 == list2.cend();
+  }
+
+  template< typename List >
+  void printList(bendryshev::OutputSink& out, const std::string& name, const List& list)
+  {
+    if (list.isEmpty())
+    {
+      bendryshev::printEmptyCommandMessage(out);
+      return;
+    }
+    S3_TRACE_SPAN("print.output");
+    unsigned long printed = 0;
+    out << name;
+    for (auto it = list.cbegin(); it != list.cend(); ++it, ++printed)
+    {
+      out << ' ' << *it;
+    }
+    out << '\n';
+    bendryshev::stats::touch(printed);
+  }
+}
+
+bendryshev::CommandMaker::CommandMaker(std::ostream& out):
+  own_out_(std::make_unique< OutputSink >(out)),
+  out_(*own_out_),
+  lists_(),
+  lazy_concat_(true),
+  fingerprints_(),
+  generations_(),
+  command_dictionary_(makeCommandDictionary()),
+  prepared_(),
+  prepared_order_(),
+  prepared_count_(0),
+  seen_lines_(new std::size_t[seen_slots]()),
+  current_(nullptr),
+  scratch_(),
+  reclaimer_(),
+  lists_version_(1),
+  positions_version_(1)
+{}
+
+bendryshev::CommandMaker::CommandMaker(OutputSink& out):
+  own_out_(),
+  out_(out),
+  lists_(),
+  lazy_concat_(true),
+  fingerprints_(),
+  generations_(),
+  command_dictionary_(makeCommandDictionary()),
+  prepared_(),
+  prepared_order_(),
+  prepared_count_(0),
+  seen_lines_(new std::size_t[seen_slots]()),
+  current_(nullptr),
+  scratch_(),
+  reclaimer_(),
+  lists_version_(1),
+  positions_version_(1)
+{}
+
+bendryshev::CommandMaker::cmd_dict bendryshev::CommandMaker::makeCommandDictionary()
+{
+  return cmd_dict(
+   {
+     { "print",    std::bind(&CommandMaker::doPrintCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "replace",  std::bind(&CommandMaker::doReplaceCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "remove",   std::bind(&CommandMaker::doRemoveCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "concat",   std::bind(&CommandMaker::doConcatCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "equal",    std::bind(&CommandMaker::doEqualCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "begin",    std::bind(&CommandMaker::doBeginCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "end",      std::bind(&CommandMaker::doEndCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "mismatch", std::bind(&CommandMaker::doMismatchCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "printPos", std::bind(&CommandMaker::doPrintPosCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "swap",     std::bind(&CommandMaker::doSwapCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "find",     std::bind(&CommandMaker::doFindCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "rotate",   std::bind(&CommandMaker::doRotateCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "swapRanges", std::bind(&CommandMaker::doSwapRangesCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "search",   std::bind(&CommandMaker::doSearchCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "save",     std::bind(&CommandMaker::doSaveCommand, this, std::placeholders::_1, std::placeholders::_2) },
+     { "load",     std::bind(&CommandMaker::doLoadCommand, this, std::placeholders::_1, std::placeholders::_2) },
+#if S3_COMMAND_STATS
+     { "stats",    std::bind(&CommandMaker::doStatsCommand, this, std::placeholders::_1, std::placeholders::_2) },
+#endif
+     { "map",      std::bind(&CommandMaker::doMapCommand, this, std::placeholders::_1, std::placeholders::_2) }
+   });
+}
+
+void bendryshev::CommandMaker::readLists(std::istream& in)
+{
+  std::string input_data(std::istreambuf_iterator< char >(in), std::istreambuf_iterator< char >{});
+  addLists(parseListFile(input_data.data(), input_data.data() + input_data.size()));
+}
+
+void bendryshev::CommandMaker::loadLists(const std::string& path, unsigned threads)
+{
+  addLists(loadListFile(path, threads));
+}
+
+void bendryshev::CommandMaker::loadListsLazily(const std::string& path)
+{
+  MappedFile file(path);
+  const char* first = file.begin();
+  const char* last = file.end();
+  while (first != last)
+  {
+    const char* line_end = findLineEnd(first, last);
+    const char* name_first = skipSeparators(first, line_end);
+    if (name_first != line_end)
+    {
+      const char* name_last = findSeparator(name_first, line_end);
+      lazy_lists_.push(std::string(name_first, name_last), lazy_range { name_last, line_end });
+    }
+    first = (line_end == last) ? last : line_end + 1;
+  }
+  mapped_files_.pushBack(std::move(file));
+}
+
+void bendryshev::CommandMaker::saveState(const std::string& path)
+{
+  materializeLazyLists();
+  std::uint32_t list_count = 0;
+  for (auto it = lists_.cbegin(); it != lists_.cend(); ++it)
+  {
+    ++list_count;
+  }
+  for (auto it = mapped_lists_.cbegin(); it != mapped_lists_.cend(); ++it)
+  {
+    ++list_count;
+  }
+  for (auto it = concat_lists_.cbegin(); it != concat_lists_.cend(); ++it)
+  {
+    ++list_count;
+  }
+  std::uint32_t position_count = 0;
+  for (auto it = positions_.cbegin(); it != positions_.cend(); ++it)
+  {
+    ++position_count;
+  }
+  SnapshotWriter writer(path, list_count, position_count);
+  for (auto it = lists_.cbegin(); it != lists_.cend(); ++it)
+  {
+    writer.writeListHeader(it->first, it->second.getSize());
+  }
+  for (auto it = mapped_lists_.cbegin(); it != mapped_lists_.cend(); ++it)
+  {
+    writer.writeListHeader(it->first, it->second.getSize());
+  }
+  for (auto it = concat_lists_.cbegin(); it != concat_lists_.cend(); ++it)
+  {
+    writer.writeListHeader(it->first, it->second.list_.getSize());
+  }
+  for (auto it = positions_.cbegin(); it != positions_.cend(); ++it)
+  {
+    writer.writePositionHeader(it->first, it->second.index_, it->second.list_.getSize());
+  }
+  for (auto it = lists_.cbegin(); it != lists_.cend(); ++it)
+  {
+    writer.writeValues(it->second.cbegin(), it->second.cend());
+  }
+  for (auto it = mapped_lists_.cbegin(); it != mapped_lists_.cend(); ++it)
+  {
+    writer.writeValues(it->second.cbegin(), it->second.cend());
+  }
+  for (auto it = concat_lists_.cbegin(); it != concat_lists_.cend(); ++it)
+  {
+    writer.writeValues(it->second.list_.cbegin(), it->second.list_.cend());
+  }
+  for (auto it = positions_.cbegin(); it != positions_.cend(); ++it)
+  {
+    writer.writeValues(it->second.list_.cbegin(), it->second.list_.cend());
+  }
+  writer.finish();
+}
+
+void bendryshev::CommandMaker::loadState(const std::string& path)
+{
+  Snapshot snapshot(path);
+  list_dict new_lists;
+  for (auto it = snapshot.lists().cbegin(); it != snapshot.lists().cend(); ++it)
+  {
+    list values;
+    Snapshot::readValues(*it, values);
+    new_lists.push(it->name_, std::move(values));
+  }
+  pos_dict new_positions;
+  for (auto it = snapshot.positions().cbegin(); it != snapshot.positions().cend(); ++it)
+  {
+    if (it->index_ < 0 || static_cast< std::size_t >(it->index_) > it->size_)
+    {
+      throw std::invalid_argument("position out of range");
+    }
+    list values;
+    Snapshot::readValues(*it, values);
+    new_positions.push(it->name_, pos { it->index_, std::move(values), list::Iterator(), std::string(), 0 });
+    rebindPosition(*new_positions.lookup(it->name_));
+  }
+  lists_.swap(new_lists);
+  positions_.swap(new_positions);
+  lazy_lists_.clear();
+  mapped_files_.clear();
+  concat_lists_.clear();
+  concat_dependents_.clear();
+  mapped_lists_.clear();
+  mapped_snapshots_.clear();
+  fingerprints_.clear();
+  generations_.clear();
+  ++lists_version_;
+  ++positions_version_;
+}
+
+void bendryshev::CommandMaker::mapLists(const std::string& path)
+{
+  static_assert(sizeof(value_t) == sizeof(std::int32_t), "snapshot values are 32-bit");
+  Snapshot snapshot(path, Snapshot::verify_table);
+  bool native_order = true;
+  {
+    const std::uint32_t probe = 1;
+    native_order = *reinterpret_cast< const unsigned char* >(&probe) == 1;
+  }
+  for (auto it = snapshot.lists().cbegin(); it != snapshot.lists().cend(); ++it)
+  {
+    dropList(it->name_);
+    if (native_order)
+    {
+      const value_t* first = reinterpret_cast< const value_t* >(it->values_);
+      mapped_lists_.push(it->name_, mapped_list(first, first + it->size_));
+    }
+    else
+    {
+      list values;
+      Snapshot::readValues(*it, values);
+      lists_.push(it->name_, std::move(values));
+    }
+  }
+  ++lists_version_;
+  mapped_snapshots_.pushBack(std::move(snapshot));
+}
+
+void bendryshev::CommandMaker::materializeLazyLists()
+{
+  BidirectionalList< std::string > names;
+  for (auto it = lazy_lists_.cbegin(); it != lazy_lists_.cend(); ++it)
+  {
+    names.pushBack(it->first);
+  }
+  for (auto&& name: names)
+  {
+    findList(name);
+  }
+}
+
+bendryshev::CommandMaker::prepared_handle* bendryshev::CommandMaker::handleFor(const std::string& name)
+{
+  if (!current_)
+  {
+    return nullptr;
+  }
+  for (auto&& handle: current_->handles_)
+  {
+    if (handle.name_ == name)
+    {
+      return std::addressof(handle);
+    }
+  }
+  current_->handles_.pushFront(prepared_handle { name, 0, nullptr, nullptr, nullptr, 0, nullptr });
+  return std::addressof(*current_->handles_.begin());
+}
+
+bendryshev::CommandMaker::list* bendryshev::CommandMaker::findList(const std::string& name)
+{
+  prepared_handle* handle = handleFor(name);
+  if (handle && handle->lists_version_ == lists_version_)
+  {
+    return handle->list_;
+  }
+  list* found = lookupList(name);
+  if (handle)
+  {
+    handle->list_ = found;
+    handle->concat_ = found ? nullptr : concat_lists_.lookup(name);
+    handle->mapped_ = (found || handle->concat_) ? nullptr : mapped_lists_.lookup(name);
+    handle->lists_version_ = lists_version_;
+  }
+  return found;
+}
+
+bendryshev::CommandMaker::mapped_list* bendryshev::CommandMaker::findMappedList(const std::string& name)
+{
+  prepared_handle* handle = handleFor(name);
+  if (handle && handle->lists_version_ == lists_version_)
+  {
+    return handle->mapped_;
+  }
+  return mapped_lists_.lookup(name);
+}
+
+bendryshev::CommandMaker::concat_entry* bendryshev::CommandMaker::findConcatList(const std::string& name)
+{
+  prepared_handle* handle = handleFor(name);
+  if (handle && handle->lists_version_ == lists_version_)
+  {
+    return handle->concat_;
+  }
+  return concat_lists_.lookup(name);
+}
+
+void bendryshev::CommandMaker::materializeConcatList(const std::string& name)
+{
+  concat_entry* concat = concat_lists_.lookup(name);
+  if (!concat)
+  {
+    return;
+  }
+  list values(concat->list_.cbegin(), concat->list_.cend());
+  concat_lists_.drop(name);
+  lists_.push(name, std::move(values));
+  touchList(name);
+  ++lists_version_;
+}
+
+void bendryshev::CommandMaker::detachDependents(const std::string& source)
+{
+  BidirectionalList< std::string >* dependents = concat_dependents_.lookup(source);
+  if (!dependents)
+  {
+    return;
+  }
+  for (auto&& name: *dependents)
+  {
+    concat_entry* concat = concat_lists_.lookup(name);
+    if (!concat)
+    {
+      continue;
+    }
+    for (auto it = concat->sources_.cbegin(); it != concat->sources_.cend(); ++it)
+    {
+      if (*it == source)
+      {
+        materializeConcatList(name);
+        break;
+      }
+    }
+  }
+  concat_dependents_.drop(source);
+}
+
+void bendryshev::CommandMaker::addSources(concat_entry& entry, const std::string& name)
+{
+  if (concat_entry* concat = findConcatList(name))
+  {
+    for (auto it = concat->sources_.cbegin(); it != concat->sources_.cend(); ++it)
+    {
+      entry.sources_.pushBack(*it);
+    }
+  }
+  else
+  {
+    entry.sources_.pushBack(name);
+  }
+}
+
+bendryshev::CommandMaker::pos* bendryshev::CommandMaker::findPosition(const std::string& name)
+{
+  prepared_handle* handle = handleFor(name);
+  if (handle && handle->positions_version_ == positions_version_)
+  {
+    return handle->pos_;
+  }
+  pos* found = positions_.lookup(name);
+  if (handle)
+  {
+    handle->pos_ = found;
+    handle->positions_version_ = positions_version_;
+  }
+  return found;
+}
+
+bendryshev::CommandMaker::pos& bendryshev::CommandMaker::getPosition(const std::string& name)
+{
+  pos* found = findPosition(name);
+  if (!found)
+  {
+    throw std::logic_error("no pos in dict");
+  }
+  return *found;
+}
+
+bendryshev::CommandMaker::list* bendryshev::CommandMaker::lookupList(const std::string& name)
+{
+  list* found = lists_.lookup(name);
+  if (found)
+  {
+    return found;
+  }
+  lazy_range* range = lazy_lists_.lookup(name);
+  if (!range)
+  {
+    return nullptr;
+  }
+  list new_list;
+  parseNumbers(range->first_, range->last_, new_list);
+  lazy_lists_.drop(name);
+  lists_.push(name, std::move(new_list));
+  ++lists_version_;
+  return lists_.lookup(name);
+}
+
+bendryshev::CommandMaker::list* bendryshev::CommandMaker::bindList(const std::string& name)
+{
+  if (findConcatList(name))
+  {
+    materializeConcatList(name);
+  }
+  list* found = findList(name);
+  if (found)
+  {
+    return found;
+  }
+  mapped_list* mapped = findMappedList(name);
+  if (!mapped)
+  {
+    return nullptr;
+  }
+  lists_.push(name, list(mapped->cbegin(), mapped->cend()));
+  mapped_lists_.drop(name);
+  touchList(name);
+  ++lists_version_;
+  return lists_.lookup(name);
+}
+
+bendryshev::CommandMaker::list& bendryshev::CommandMaker::getList(const std::string& name)
+{
+  detachDependents(name);
+  fingerprints_.drop(name);
+  list* found = bindList(name);
+  if (!found)
+  {
+    throw std::logic_error("no list in dict");
+  }
+  touchList(name);
+  return *found;
+}
+
+void bendryshev::CommandMaker::dropList(const std::string& name)
+{
+  detachDependents(name);
+  concat_lists_.drop(name);
+  if (list* found = lists_.lookup(name))
+  {
+    retireList(*found);
+  }
+  lists_.drop(name);
+  lazy_lists_.drop(name);
+  mapped_lists_.drop(name);
+  fingerprints_.drop(name);
+  touchList(name);
+  ++lists_version_;
+}
+
+void bendryshev::CommandMaker::touchList(const std::string& name)
+{
+  if (unsigned long* found = generations_.lookup(name))
+  {
+    *found = nextGeneration();
+    return;
+  }
+  generations_.push(name, nextGeneration());
+}
+
+unsigned long bendryshev::CommandMaker::generationOf(const std::string& name)
+{
+  const unsigned long* found = generations_.lookup(name);
+  return found ? *found : 0;
+}
+
+void bendryshev::CommandMaker::retireList(list& values)
+{
+  // Short lists are cheaper to free in place than to hand to the reclaimer thread.
+  auto it = values.cbegin();
+  for (unsigned long i = 0; i < reclaim_threshold && it != values.cend(); ++i)
+  {
+    ++it;
+  }
+  if (it != values.cend())
+  {
+    reclaimer_.retire(std::move(values));
+  }
+}
+
+const bendryshev::CommandMaker::fingerprint& bendryshev::CommandMaker::fingerprintOf(const std::string& name)
+{
+  if (const fingerprint* found = fingerprints_.lookup(name))
+  {
+    return *found;
+  }
+  fingerprint computed;
+  visitList(name, [&computed](const auto& source)
+  {
+    computed = fingerprint::of(source);
+  });
+  stats::touch(computed.getSize());
+  fingerprints_.push(name, computed);
+  return *fingerprints_.lookup(name);
+}
+
+void bendryshev::CommandMaker::setFingerprint(const std::string& name, const fingerprint& print)
+{
+  if (fingerprint* found = fingerprints_.lookup(name))
+  {
+    *found = print;
+    return;
+  }
+  fingerprints_.push(name, print);
+}
+
+void bendryshev::CommandMaker::pushPosition(const std::string& name, value_t index, const std::string& list_name,
+    const list& source, list::ConstIterator it)
+{
+  setPosition(name, pos { index, source, list::Iterator(it), list_name, generationOf(list_name) });
+}
+
+template< typename List >
+void bendryshev::CommandMaker::pushPosition(const std::string& name, value_t index, const std::string& list_name,
+    const List& source, typename List::ConstIterator)
+{
+  // The position walks its own copy until a mutation through it binds the list and moves it to the live nodes.
+  pos position { index, list(source.cbegin(), source.cend()), list::Iterator(), list_name, generationOf(list_name) };
+  rebindPosition(setPosition(name, std::move(position)));
+}
+
+bendryshev::CommandMaker::pos& bendryshev::CommandMaker::setPosition(const std::string& name, pos&& position)
+{
+  ++positions_version_;
+  if (pos* found = positions_.lookup(name))
+  {
+    retireList(found->list_);
+    *found = std::move(position);
+    return *found;
+  }
+  positions_.push(name, std::move(position));
+  return *positions_.lookup(name);
+}
+
+void bendryshev::CommandMaker::rebindPosition(pos& position)
+{
+  position.iter_ = position.list_.begin();
+  for (value_t i = 0; i < position.index_; ++i)
+  {
+    ++position.iter_;
+  }
+}
+
+bool bendryshev::CommandMaker::refreshPosition(pos& position)
+{
+  if (position.list_name_.empty())
+  {
+    return false;
+  }
+  if (position.generation_ == generationOf(position.list_name_))
+  {
+    return true;
+  }
+  if (!lists_.lookup(position.list_name_) && !bindList(position.list_name_))
+  {
+    // Only a shard that was routed the position without its list gets here, and it cannot check the nodes.
+    return true;
+  }
+  resolvePositions(position.list_name_);
+  return position.generation_ == generationOf(position.list_name_);
+}
+
+void bendryshev::CommandMaker::resolvePositions(const std::string& name)
+{
+  // A mutation may have freed the nodes these positions held; find them again by index in one walk of the list.
+  unsigned long generation = generationOf(name);
+  auto is_stale = [&](const pos& other)
+  {
+    return other.list_name_ == name && other.generation_ != generation;
+  };
+  std::size_t count = 0;
+  for (auto it = positions_.cbegin(); it != positions_.cend(); ++it)
+  {
+    count += is_stale(it->second) ? 1 : 0;
+  }
+  std::unique_ptr< pos*[] > stale(new pos*[count]);
+  std::size_t filled = 0;
+  for (auto it = positions_.begin(); it != positions_.end(); ++it)
+  {
+    if (is_stale(it->second))
+    {
+      stale[filled++] = std::addressof(it->second);
+    }
+  }
+  std::sort(stale.get(), stale.get() + count, [](const pos* lhs, const pos* rhs)
+  {
+    return lhs->index_ < rhs->index_;
+  });
+  list& values = *lists_.lookup(name);
+  list::Iterator node = values.begin();
+  value_t index = 0;
+  for (std::size_t i = 0; i < count && stale[i]->index_ >= 0; ++i)
+  {
+    for (; index < stale[i]->index_ && node != values.end(); ++index)
+    {
+      ++node;
+    }
+    if (index < stale[i]->index_)
+    {
+      break;
+    }
+    stale[i]->iter_ = node;
+    stale[i]->generation_ = generation;
+  }
+  stats::touch(static_cast< unsigned long >(index));
+}
+
+void bendryshev::CommandMaker::addLists(BidirectionalList< loaded_list >&& new_lists)
+{
+  for (auto&& item: new_lists)
+  {
+    lists_.push(item.first, std::move(item.second));
+  }
+  ++lists_version_;
+}
+
+void bendryshev::CommandMaker::openJournal(const std::string& path)
+{
+  std::uint64_t valid_size = 0;
+  if (::access(path.c_str(), F_OK) == 0)
+  {
+    JournalReader reader(path);
+    JournalRecord record;
+    while (reader.next(record))
+    {
+      applyRecord(record);
+    }
+    valid_size = reader.validSize();
+  }
+  journal_ = std::make_unique< JournalWriter >(path, valid_size);
+}
+
+void bendryshev::CommandMaker::setLazyConcat(bool enabled) noexcept
+{
+  lazy_concat_ = enabled;
+}
+
+bendryshev::BidirectionalList< std::string > bendryshev::CommandMaker::entryNames() const
+{
+  BidirectionalList< std::string > names;
+  for (auto it = lists_.cbegin(); it != lists_.cend(); ++it)
+  {
+    names.pushBack(it->first);
+  }
+  for (auto it = lazy_lists_.cbegin(); it != lazy_lists_.cend(); ++it)
+  {
+    names.pushBack(it->first);
+  }
+  for (auto it = mapped_lists_.cbegin(); it != mapped_lists_.cend(); ++it)
+  {
+    names.pushBack(it->first);
+  }
+  for (auto it = concat_lists_.cbegin(); it != concat_lists_.cend(); ++it)
+  {
+    names.pushBack(it->first);
+  }
+  for (auto it = positions_.cbegin(); it != positions_.cend(); ++it)
+  {
+    names.pushBack(it->first);
+  }
+  return names;
+}
+
+void bendryshev::CommandMaker::moveEntries(const std::string& name, CommandMaker& dest)
+{
+  detachDependents(name);
+  materializeConcatList(name);
+  if (list* found = lists_.lookup(name))
+  {
+    dest.dropList(name);
+    dest.lists_.push(name, std::move(*found));
+    lists_.drop(name);
+  }
+  if (lazy_range* range = lazy_lists_.lookup(name))
+  {
+    dest.dropList(name);
+    dest.lazy_lists_.push(name, *range);
+    lazy_lists_.drop(name);
+  }
+  if (mapped_list* mapped = mapped_lists_.lookup(name))
+  {
+    dest.dropList(name);
+    dest.mapped_lists_.push(name, *mapped);
+    mapped_lists_.drop(name);
+  }
+  if (fingerprint* print = fingerprints_.lookup(name))
+  {
+    dest.fingerprints_.push(name, *print);
+    fingerprints_.drop(name);
+  }
+  if (unsigned long* generation = generations_.lookup(name))
+  {
+    dest.touchList(name);
+    *dest.generations_.lookup(name) = *generation;
+    generations_.drop(name);
+  }
+  if (pos* position = positions_.lookup(name))
+  {
+    if (pos* replaced = dest.positions_.lookup(name))
+    {
+      dest.retireList(replaced->list_);
+    }
+    dest.positions_.drop(name);
+    dest.positions_.push(name, std::move(*position));
+    positions_.drop(name);
+  }
+  ++lists_version_;
+  ++positions_version_;
+  ++dest.lists_version_;
+  ++dest.positions_version_;
+}
+
+void bendryshev::CommandMaker::applyRecord(const JournalRecord& record)
+{
+  switch (record.op_)
+  {
+  case JournalOp::replace_value:
+    replaceValues(record.name_, record.first_, record.second_);
+    break;
+  case JournalOp::replace_list:
+    replaceByList(record.name_, record.first_, record.lists_.getFrontData());
+    break;
+  case JournalOp::remove_value:
+    removeValues(record.name_, record.first_);
+    break;
+  case JournalOp::remove_list:
+    removeByList(record.name_, record.lists_.getFrontData());
+    break;
+  case JournalOp::concat:
+  {
+    const command_list sources(record.lists_.cbegin(), record.lists_.cend());
+    concatLists(record.name_, sources.cbegin(), sources.cend());
+    break;
+  }
+  case JournalOp::assign_list:
+  {
+    list values(record.values_.cbegin(), record.values_.cend());
+    dropList(record.name_);
+    lists_.push(record.name_, std::move(values));
+    break;
+  }
+  case JournalOp::load_snapshot:
+    loadState(record.name_);
+    break;
+  case JournalOp::map_snapshot:
+    mapLists(record.name_);
+    break;
+  }
+}
+
+void bendryshev::CommandMaker::journalList(const std::string& name)
+{
+  // Position edits cannot be replayed by name, so the journal keeps the list they left behind.
+  const list* found = lists_.lookup(name);
+  if (journal_ && found)
+  {
+    journal_->assignList(name, found->cbegin(), found->cend());
+  }
+}
+
+void bendryshev::CommandMaker::replaceValues(const std::string& name, value_t from, value_t to)
+{
+  setFingerprint(name, replace(getList(name), from, to));
+  if (journal_)
+  {
+    journal_->replaceValue(name, from, to);
+  }
+}
+
+void bendryshev::CommandMaker::replaceByList(const std::string& name, value_t from, const std::string& arg_name)
+{
+  list& dest_list = getList(name);
+  if (arg_name == name)
+  {
+    // replace() copies the argument into the scratch arena before it edits the destination.
+    setFingerprint(name, replace(dest_list, from, dest_list, scratch_));
+  }
+  else
+  {
+    visitList(arg_name, [&](const auto& arg_list)
+    {
+      setFingerprint(name, replace(dest_list, from, arg_list, scratch_));
+    });
+  }
+  if (journal_)
+  {
+    journal_->replaceList(name, from, arg_name);
+  }
+}
+
+void bendryshev::CommandMaker::removeValues(const std::string& name, value_t value)
+{
+  setFingerprint(name, remove(getList(name), value));
+  if (journal_)
+  {
+    journal_->removeValue(name, value);
+  }
+}
+
+void bendryshev::CommandMaker::removeByList(const std::string& name, const std::string& arg_name)
+{
+  list& dest_list = getList(name);
+  if (arg_name == name)
+  {
+    retireList(dest_list);
+    dest_list.clear();
+    setFingerprint(name, fingerprint());
+  }
+  else
+  {
+    visitList(arg_name, [&](const auto& arg_list)
+    {
+      setFingerprint(name, remove(dest_list, arg_list, scratch_));
+    });
+  }
+  if (journal_)
+  {
+    journal_->removeList(name, arg_name);
+  }
+}
+
+void bendryshev::CommandMaker::concatLists(const std::string& name, command_list::ConstIterator first,
+    command_list::ConstIterator last)
+{
+  fingerprint concat_print;
+  bool concat_print_known = true;
+  for (auto it = first; it != last && concat_print_known; ++it)
+  {
+    const fingerprint* source_print = fingerprints_.lookup(*it);
+    concat_print_known = source_print != nullptr;
+    if (source_print)
+    {
+      concat_print.append(*source_print);
+    }
+  }
+  concat_entry entry;
+  if (lazy_concat_)
+  {
+    for (auto it = first; it != last; ++it)
+    {
+      visitList(*it, [&entry](const auto& source)
+      {
+        appendSegment(entry.list_, source);
+      });
+      addSources(entry, *it);
+    }
+  }
+  bool self_referencing = false;
+  for (auto it = entry.sources_.cbegin(); it != entry.sources_.cend(); ++it)
+  {
+    self_referencing = self_referencing || *it == name;
+  }
+  if (!lazy_concat_ || self_referencing)
+  {
+    list concat_list;
+    for (auto it = first; it != last; ++it)
+    {
+      visitList(*it, [&concat_list](const auto& source)
+      {
+        pushBack(concat_list, source);
+      });
+    }
+    dropList(name);
+    lists_.push(name, std::move(concat_list));
+  }
+  else
+  {
+    dropList(name);
+    for (auto it = entry.sources_.cbegin(); it != entry.sources_.cend(); ++it)
+    {
+      if (BidirectionalList< std::string >* dependents = concat_dependents_.lookup(*it))
+      {
+        dependents->pushBack(name);
+      }
+      else
+      {
+        concat_dependents_.push(*it, BidirectionalList< std::string > { name });
+      }
+    }
+    concat_lists_.push(name, std::move(entry));
+  }
+  if (concat_print_known)
+  {
+    setFingerprint(name, concat_print);
+  }
+  if (journal_)
+  {
+    journal_->concat(name, first, last);
+  }
+}
+
+void bendryshev::CommandMaker::doCommand(bendryshev::command_list& commandList)
+{
+  assert(!commandList.isEmpty());
+  execute(command_dictionary_.lookup(commandList.getFrontData()), commandList, accounting::snapshot());
+  scratch_.reset();
+}
+
+void bendryshev::CommandMaker::doCommand(const std::string& line)
+{
+  doCommand(line, command_list());
+}
+
+void bendryshev::CommandMaker::doCommand(const std::string& line, command_list&& split_tokens)
+{
+  accounting::Counts memory = accounting::snapshot();
+  prepared_command* prepared = prepared_.lookup(line);
+  if (prepared && prepared->recency_ != prepared_order_.begin())
+  {
+    auto next = prepared->recency_;
+    prepared_order_.splice(prepared_order_.begin(), prepared_order_, prepared->recency_, ++next);
+  }
+  else if (!prepared)
+  {
+    // A line is only worth preparing once it repeats; the first sighting runs unprepared and leaves its hash.
+    std::size_t hash = std::hash< std::string >()(line);
+    std::size_t& seen = seen_lines_[hash % seen_slots];
+    command_list tokens = split_tokens.isEmpty() ? split(line, scratch_.resource()) : std::move(split_tokens);
+    assert(!tokens.isEmpty());
+    commandsAction* action = command_dictionary_.lookup(tokens.getFrontData());
+    if (seen != hash)
+    {
+      seen = hash;
+      execute(action, tokens, memory);
+      // Only temporaries that die with the command live in the arena, and the tokens are among them. Position
+      // copies, concat results and dictionary nodes outlive it and still come from the heap.
+      tokens.clear();
+      scratch_.reset();
+      return;
+    }
+    S3_TRACE_SPAN("prepare");
+    if (prepared_count_ == max_prepared)
+    {
+      prepared_.drop(prepared_order_.getBackData());
+      prepared_order_.popBack();
+      --prepared_count_;
+    }
+    prepared_order_.pushFront(line);
+    prepared_.push(line, prepared_command { command_list(tokens), action, BidirectionalList< prepared_handle >(), nullptr,
+        prepared_order_.begin() });
+    ++prepared_count_;
+    prepared = prepared_.lookup(line);
+  }
+  current_ = prepared;
+  execute(prepared->action_, prepared->tokens_, memory);
+  current_ = nullptr;
+  scratch_.reset();
+}
+
+void bendryshev::CommandMaker::execute(commandsAction* action, command_list& commandList, const accounting::Counts& memory)
+{
+#if S3_COMMAND_STATS
+  CommandCounters* counters = current_ ? current_->counters_ : nullptr;
+  if (!counters)
+  {
+    counters = std::addressof(stats_.counters(action ? commandList.getFrontData() : std::string("<unknown>")));
+    if (current_)
+    {
+      current_->counters_ = counters;
+    }
+  }
+  stats::touched_elements = 0;
+  PerfCounters* events = perf::threadCounters();
+  PerfSample sample;
+  if (!events || !events->read(sample))
+  {
+    events = nullptr;
+  }
+  auto started = std::chrono::steady_clock::now();
+#endif
+  S3_TRACE_SPAN(commandList.getFrontData());
+  bool failed = false;
+  try
+  {
+    if (action)
+    {
+      command_list_iterator begin = commandList.begin();
+      (*action)(++begin, commandList.end());
+    }
+    else
+    {
+      failed = true;
+      bendryshev::printInvalidCommandMessage(out_);
+    }
+  }
+  catch (const std::logic_error&)
+  {
+    failed = true;
+    bendryshev::printInvalidCommandMessage(out_);
+  }
+#if S3_COMMAND_STATS
+  auto elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - started);
+  counters->record(static_cast< std::uint64_t >(elapsed.count()), failed, stats::touched_elements);
+  if (events && events->elapsed(sample))
+  {
+    counters->record(sample);
+  }
+  counters->record(accounting::since(memory));
+#else
+  static_cast< void >(failed);
+  static_cast< void >(memory);
+#endif
+  if (own_out_)
+  {
+    flush();
+  }
+}
+
+void bendryshev::CommandMaker::flush()
+{
+  S3_TRACE_SPAN("flush");
+  if (journal_)
+  {
+    journal_->commit();
+  }
+  out_.flush();
+}
+
+void bendryshev::CommandMaker::doPrintCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  if (begin != end)
+  {
+    throw std::logic_error("");
+  }
+  visitList(list_name, [&](const auto& new_list)
+  {
+    printList(out_, list_name, new_list);
+  });
+}
+
+
+void bendryshev::CommandMaker::doReplaceCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  value_t first_value = parseNumber(*(begin++));
+  checkEndOfCommand(begin, end);
+  const std::string& next_part = *(begin++);
+  value_t next_value = 0;
+  if (tryParseNumber(next_part, next_value))
+  {
+    replaceValues(list_name, first_value, next_value);
+  }
+  else
+  {
+    replaceByList(list_name, first_value, next_part);
+  }
+}
+
+void bendryshev::CommandMaker::doRemoveCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& next_part = *(begin++);
+  value_t value_to_delete = 0;
+  if (tryParseNumber(next_part, value_to_delete))
+  {
+    removeValues(list_name, value_to_delete);
+  }
+  else
+  {
+    removeByList(list_name, next_part);
+  }
+}
+
+void bendryshev::CommandMaker::doConcatCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  command_list_iterator sources_begin = begin++;
+  checkEndOfCommand(begin, end);
+  concatLists(list_name, sources_begin, end);
+}
+
+void bendryshev::CommandMaker::doEqualCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& first_list_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const fingerprint first_print = fingerprintOf(first_list_name);
+  bool is_equal = true;
+  while (begin != end && is_equal)
+  {
+    const std::string& next_list_name = *(begin++);
+    is_equal = fingerprintOf(next_list_name) == first_print;
+    if (is_equal)
+    {
+      visitList(first_list_name, [&](const auto& first_list)
+      {
+        visitList(next_list_name, [&](const auto& next_list)
+        {
+          is_equal = isEqual(first_list, next_list);
+        });
+      });
+    }
+  }
+  if (is_equal)
+  {
+    bendryshev::printTrueMessage(out_);
+  }
+  else
+  {
+    bendryshev::printFalseMessage(out_);
+  }
+}
+
+void bendryshev::CommandMaker::doBeginCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  visitList(list_name, [&](const auto& list)
+  {
+    pushPosition(pos_name, 0, list_name, list, list.cbegin());
+  });
+}
+
+void bendryshev::CommandMaker::doEndCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  visitList(list_name, [&](const auto& list)
+  {
+    pushPosition(pos_name, static_cast< value_t >(list.getSize()), list_name, list, list.cend());
+  });
+}
+
+void bendryshev::CommandMaker::doMismatchCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& list1_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& list2_name = *(begin++);
+  visitList(list1_name, [&](const auto& list1)
+  {
+    visitList(list2_name, [&](const auto& list2)
+    {
+      value_t count = 0;
+      auto it1 = list1.cbegin();
+      auto it2 = list2.cbegin();
+      while (it1 != list1.cend() && it2 != list2.cend())
+      {
+        if (*it1 != *it2)
+        {
+          break;
+        }
+        ++count;
+        ++it1;
+        ++it2;
+      }
+      stats::touch(static_cast< unsigned long >(count));
+      pushPosition(pos_name, count, list1_name, list1, it1);
+    });
+  });
+}
+
+void bendryshev::CommandMaker::doPrintPosCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos_name = *(begin++);
+  const pos& new_pos = getPosition(pos_name);
+  if (begin == end)
+  {
+    out_ << pos_name << ' ';
+    out_ << new_pos.index_ << '\n';
+  }
+  else
+  {
+    throw std::logic_error("");
+  }
+}
+
+void bendryshev::CommandMaker::doSwapCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos1_name = *(begin++);
+  pos& pos1 = getPosition(pos1_name);
+  checkEndOfCommand(begin, end);
+  const std::string& pos2_name = *(begin++);
+  pos& pos2 = getPosition(pos2_name);
+  std::swap(pos1, pos2);
+}
+
+void bendryshev::CommandMaker::doFindCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& list_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  value_t elem = parseNumber(*(begin++));
+  visitList(list_name, [&](const auto& list)
+  {
+    value_t count = 0;
+    auto it = list.cbegin();
+    while (it != list.cend() && *it != elem)
+    {
+      ++count;
+      ++it;
+    }
+    stats::touch(static_cast< unsigned long >(count));
+    pushPosition(pos_name, count, list_name, list, it);
+  });
+}
+
+void bendryshev::CommandMaker::doRotateCommand(command_list_iterator begin, command_list_iterator end)
+{
+  rotateRanges(begin, end, false);
+}
+
+void bendryshev::CommandMaker::doSwapRangesCommand(command_list_iterator begin, command_list_iterator end)
+{
+  rotateRanges(begin, end, true);
+}
+
+void bendryshev::CommandMaker::rotateRanges(command_list_iterator begin, command_list_iterator end, bool any_length)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos1_name = *(begin++);
+  pos& pos1 = getPosition(pos1_name);
+  checkEndOfCommand(begin,end);
+  const std::string& pos2_name = *(begin++);
+  pos& pos2 = getPosition(pos2_name);
+  checkEndOfCommand(begin,end);
+  const std::string& pos3_name = *(begin++);
+  pos& pos3 = getPosition(pos3_name);
+  checkEndOfCommand(begin,end);
+  const std::string& pos4_name = *(begin++);
+  pos& pos4 = getPosition(pos4_name);
+  if (pos2.index_ < pos1.index_ || pos4.index_ < pos3.index_)
+  {
+    throw std::logic_error("");
+  }
+  // Every node is taken from the positions, so all four must have been resolved since their list last changed.
+  // A rope or mapped list is bound first; that moves positions off their copies and onto the live nodes.
+  std::initializer_list< pos* > bound = { std::addressof(pos1), std::addressof(pos2), std::addressof(pos3),
+    std::addressof(pos4) };
+  for (pos* position: bound)
+  {
+    if (!position->list_name_.empty() && !lists_.lookup(position->list_name_))
+    {
+      bindList(position->list_name_);
+    }
+  }
+  for (pos* position: bound)
+  {
+    if (!refreshPosition(*position))
+    {
+      throw std::logic_error("");
+    }
+  }
+  bool first_is_lower = pos1.index_ <= pos3.index_;
+  pos& lower_begin = first_is_lower ? pos1 : pos3;
+  pos& lower_end = first_is_lower ? pos2 : pos4;
+  pos& upper_begin = first_is_lower ? pos3 : pos1;
+  pos& upper_end = first_is_lower ? pos4 : pos2;
+  const std::string& list_name = pos1.list_name_;
+  bool relinkable = pos2.list_name_ == list_name && pos3.list_name_ == list_name && pos4.list_name_ == list_name
+    && lower_end.index_ <= upper_begin.index_ && lists_.lookup(list_name);
+  if (!relinkable)
+  {
+    // The element-wise walk from pos1 only reaches pos2 when both bracket the same live list.
+    bool walkable = pos2.list_name_ == pos1.list_name_ && pos4.list_name_ == pos3.list_name_;
+    if (any_length || !walkable || !isEqualRange(pos1, pos2, pos3, pos4))
+    {
+      throw std::logic_error("");
+    }
+    for (auto&& name: { pos1.list_name_, pos3.list_name_ })
+    {
+      detachDependents(name);
+      fingerprints_.drop(name);
+    }
+    auto iter1 = pos1.iter_;
+    auto iter2 = pos3.iter_;
+    while (iter1 != pos2.iter_)
+    {
+      std::iter_swap(iter1, iter2);
+      ++iter1;
+      ++iter2;
+    }
+    stats::touch(2 * static_cast< unsigned long >(pos2.index_ - pos1.index_));
+    journalList(pos1.list_name_);
+    if (pos3.list_name_ != pos1.list_name_)
+    {
+      journalList(pos3.list_name_);
+    }
+    return;
+  }
+  if (!any_length && !isEqualRange(pos1, pos2, pos3, pos4))
+  {
+    throw std::logic_error("");
+  }
+  detachDependents(list_name);
+  fingerprints_.drop(list_name);
+  value_t lower_length = lower_end.index_ - lower_begin.index_;
+  value_t gap_length = upper_begin.index_ - lower_end.index_;
+  value_t upper_length = upper_end.index_ - upper_begin.index_;
+  auto is_bystander = [&](const pos& other)
+  {
+    bool bound = std::addressof(other) == std::addressof(pos1) || std::addressof(other) == std::addressof(pos2)
+      || std::addressof(other) == std::addressof(pos3) || std::addressof(other) == std::addressof(pos4);
+    return !bound && other.list_name_ == list_name && other.index_ >= lower_begin.index_ && other.index_ < upper_end.index_;
+  };
+  for (auto it = positions_.begin(); any_length && it != positions_.end(); ++it)
+  {
+    pos& other = it->second;
+    if (!is_bystander(other))
+    {
+      continue;
+    }
+    if (other.index_ < lower_end.index_)
+    {
+      other.index_ += upper_length + gap_length;
+    }
+    else if (other.index_ < upper_begin.index_)
+    {
+      other.index_ += upper_length - lower_length;
+    }
+    else
+    {
+      other.index_ -= lower_length + gap_length;
+    }
+  }
+  list::Iterator lower_first = lower_begin.iter_;
+  list::Iterator gap_first = lower_end.iter_;
+  list::Iterator upper_first = upper_begin.iter_;
+  list::Iterator tail_first = upper_end.iter_;
+  lists_.lookup(list_name)->swapRanges(lower_first, gap_first, upper_first, tail_first);
+  list::Iterator moved_lower = lower_length != 0 ? lower_first : tail_first;
+  list::Iterator after_upper = gap_length != 0 ? gap_first : moved_lower;
+  value_t base = lower_begin.index_;
+  lower_begin.iter_ = upper_length != 0 ? upper_first : after_upper;
+  lower_end.index_ = base + upper_length;
+  lower_end.iter_ = after_upper;
+  upper_begin.index_ = base + upper_length + gap_length;
+  upper_begin.iter_ = moved_lower;
+  if (!any_length)
+  {
+    repointBystanders(lower_begin, is_bystander);
+  }
+  journalList(list_name);
+}
+
+template< typename Predicate >
+void bendryshev::CommandMaker::repointBystanders(const pos& first, Predicate is_bystander)
+{
+  // rotate used to swap values in place, so other positions keep their index and take the node now found there.
+  std::size_t count = 0;
+  for (auto it = positions_.cbegin(); it != positions_.cend(); ++it)
+  {
+    count += is_bystander(it->second) ? 1 : 0;
+  }
+  if (count == 0)
+  {
+    return;
+  }
+  std::unique_ptr< pos*[] > bystanders(new pos*[count]);
+  std::size_t filled = 0;
+  for (auto it = positions_.begin(); it != positions_.end(); ++it)
+  {
+    if (is_bystander(it->second))
+    {
+      bystanders[filled++] = std::addressof(it->second);
+    }
+  }
+  std::sort(bystanders.get(), bystanders.get() + count, [](const pos* lhs, const pos* rhs)
+  {
+    return lhs->index_ < rhs->index_;
+  });
+  list::Iterator node = first.iter_;
+  value_t index = first.index_;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (; index < bystanders[i]->index_; ++index)
+    {
+      ++node;
+    }
+    bystanders[i]->iter_ = node;
+  }
+  stats::touch(static_cast< unsigned long >(index - first.index_));
+}
+
+void bendryshev::CommandMaker::doSearchCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& pos_name = *(begin++);
+  checkEndOfCommand(begin, end);
+  const std::string& pos1_name = *(begin++);
+  pos& pos1 = getPosition(pos1_name);
+  checkEndOfCommand(begin, end);
+  const std::string& pos2_name = *(begin++);
+  pos& pos2 = getPosition(pos2_name);
+  if (pos1.list_ != pos2.list_)
+  {
+    throw std::logic_error("");
+  }
+  for (pos* position: { std::addressof(pos1), std::addressof(pos2) })
+  {
+    if (!position->list_name_.empty() && !refreshPosition(*position))
+    {
+      throw std::logic_error("");
+    }
+  }
+  checkEndOfCommand(begin, end);
+  value_t elem = parseNumber(*(begin++));
+  value_t count = pos1.index_;
+  auto it = pos1.iter_;
+  while (count < pos2.index_)
+  {
+    if (*it == elem)
+    {
+      break;
+    }
+    ++count;
+    ++it;
+  }
+  stats::touch(static_cast< unsigned long >(count - pos1.index_));
+  setPosition(pos_name, pos { count, pos1.list_, it, pos1.list_name_, pos1.generation_ });
+}
+
+
+void bendryshev::CommandMaker::doSaveCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& path = *(begin++);
+  if (begin != end)
+  {
+    throw std::logic_error("");
+  }
+  try
+  {
+    saveState(path);
+  }
+  catch (const std::runtime_error& e)
+  {
+    throw std::logic_error(e.what());
+  }
+}
+
+void bendryshev::CommandMaker::doLoadCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& path = *(begin++);
+  if (begin != end)
+  {
+    throw std::logic_error("");
+  }
+  try
+  {
+    loadState(path);
+  }
+  catch (const std::runtime_error& e)
+  {
+    throw std::logic_error(e.what());
+  }
+  if (journal_)
+  {
+    journal_->loadSnapshot(path);
+  }
+}
+
+void bendryshev::CommandMaker::doMapCommand(command_list_iterator begin, command_list_iterator end)
+{
+  checkEndOfCommand(begin, end);
+  const std::string& path = *(begin++);
+  if (begin != end)
+  {
+    throw std::logic_error("");
+  }
+  try
+  {
+    mapLists(path);
+  }
+  catch (const std::runtime_error& e)
+  {
+    throw std::logic_error(e.what());
+  }
+  if (journal_)
+  {
+    journal_->mapSnapshot(path);
+  }
+}
+
+#if S3_COMMAND_STATS
+const bendryshev::CommandStats& bendryshev::CommandMaker::stats() const noexcept
+{
+  return stats_;
+}
+
+void bendryshev::CommandMaker::doStatsCommand(command_list_iterator begin, command_list_iterator end)
+{
+  if (begin != end)
+  {
+    throw std::logic_error("");
+  }
+  stats_.print(out_);
+}
+#endif
@@ -1,55 +1,226 @@
-#ifndef S3_COMMANDMAKER_H
-#define S3_COMMANDMAKER_H
-
-#include <string>
-#include <functional>
-#include "data_structures/BidirectionalList.h"
-#include "data_structures/TreeDictionary.h"
-
-namespace bendryshev
-{
-  BidirectionalList< std::string > split(const std::string&);
-  BidirectionalList< std::string > readListFromStream(std::istream&);
-
-  class CommandMaker
-  {
-  public:
-    using command = std::string;
-    using value_t = int;
-    using command_list_iterator = bendryshev::BidirectionalList< command >::Iterator;
-    using commandsAction = std::function< void(command_list_iterator, command_list_iterator) >;
-    using cmd_dict = TreeDictionary< command, commandsAction, std::less< > >;
-    using list_dict = TreeDictionary< std::string, BidirectionalList< value_t >, std::less< > >;
-    struct pos
-    {
-      value_t index_;
-      BidirectionalList< value_t > list_;
-      BidirectionalList< value_t >::Iterator iter_;
-    };
-    using pos_dict = TreeDictionary< std::string, pos, std::less< > >;
-    using list = BidirectionalList< value_t >;
-    explicit CommandMaker(std::ostream&);
-    void readLists(std::istream&);
-    void doCommand(BidirectionalList< command >&);
-  private:
-    std::ostream& out_;
-    list_dict lists_;
-    pos_dict positions_;
-    cmd_dict command_dictionary_;
-    void doPrintCommand(command_list_iterator, command_list_iterator);
-    void doReplaceCommand(command_list_iterator, command_list_iterator);
-    void doRemoveCommand(command_list_iterator, command_list_iterator);
-    void doConcatCommand(command_list_iterator, command_list_iterator);
-    void doEqualCommand(command_list_iterator, command_list_iterator);
-    void doBeginCommand(command_list_iterator, command_list_iterator);
-    void doEndCommand(command_list_iterator, command_list_iterator);
-    void doMismatchCommand(command_list_iterator, command_list_iterator);
-    void doPrintPosCommand(command_list_iterator, command_list_iterator);
-    void doSwapCommand(command_list_iterator, command_list_iterator);
-    void doFindCommand(command_list_iterator, command_list_iterator);
-    void doRotateCommand(command_list_iterator, command_list_iterator);
-    void doSearchCommand(command_list_iterator, command_list_iterator);
-  };
-}
-
-#endif
+#ifndef S3_COMMANDMAKER_H
+#define S3_COMMANDMAKER_H
+
+#include <string>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include "commands/CommandStats.h"
+#include "data_structures/BidirectionalList.h"
+#include "data_structures/ConcatList.h"
+#include "data_structures/DeferredReclaimer.h"
+#include "data_structures/ListFingerprint.h"
+#include "data_structures/MappedList.h"
+#include "data_structures/ScratchArena.h"
+#include "data_structures/TreeDictionary.h"
+#include "io/OutputSink.h"
+#include "io/Journal.h"
+#include "io/ListFileLoader.h"
+#include "io/MappedFile.h"
+#include "io/Snapshot.h"
+
+namespace bendryshev
+{
+  using command_list = BidirectionalList< std::string, std::pmr::polymorphic_allocator< std::string > >;
+  command_list split(const std::string&, std::pmr::memory_resource* = std::pmr::get_default_resource());
+  BidirectionalList< std::string > readListFromStream(std::istream&);
+
+  class CommandMaker
+  {
+  public:
+    using command = std::string;
+    using value_t = int;
+    using command_list_iterator = command_list::Iterator;
+    using commandsAction = std::function< void(command_list_iterator, command_list_iterator) >;
+    using cmd_dict = TreeDictionary< command, commandsAction, std::less< > >;
+    using list_dict = TreeDictionary< std::string, BidirectionalList< value_t >, std::less< > >;
+    struct pos
+    {
+      value_t index_;
+      BidirectionalList< value_t > list_;
+      BidirectionalList< value_t >::Iterator iter_;
+      std::string list_name_;
+      unsigned long generation_;
+    };
+    using pos_dict = TreeDictionary< std::string, pos, std::less< > >;
+    using list = BidirectionalList< value_t >;
+    using scratch_list = BidirectionalList< value_t, std::pmr::polymorphic_allocator< value_t > >;
+    using mapped_list = MappedList< value_t >;
+    using mapped_dict = TreeDictionary< std::string, mapped_list, std::less< > >;
+    using concat_list = ConcatList< value_t >;
+    using fingerprint = ListFingerprint< value_t >;
+    explicit CommandMaker(std::ostream&);
+    explicit CommandMaker(OutputSink&);
+    void readLists(std::istream&);
+    void loadLists(const std::string&, unsigned threads = 0);
+    void loadListsLazily(const std::string&);
+    void saveState(const std::string&);
+    void loadState(const std::string&);
+    void mapLists(const std::string&);
+    void openJournal(const std::string&);
+    void setLazyConcat(bool) noexcept;
+    BidirectionalList< std::string > entryNames() const;
+    void moveEntries(const std::string&, CommandMaker&);
+    void doCommand(command_list&);
+    void doCommand(const std::string&);
+    void doCommand(const std::string&, command_list&&);
+    void flush();
+#if S3_COMMAND_STATS
+    const CommandStats& stats() const noexcept;
+#endif
+  private:
+    struct lazy_range
+    {
+      const char* first_;
+      const char* last_;
+    };
+    using lazy_dict = TreeDictionary< std::string, lazy_range, std::less< > >;
+    struct concat_entry
+    {
+      concat_list list_;
+      BidirectionalList< std::string > sources_;
+    };
+    using concat_dict = TreeDictionary< std::string, concat_entry, std::less< > >;
+    using dependents_dict = TreeDictionary< std::string, BidirectionalList< std::string >, std::less< > >;
+    using fingerprint_dict = TreeDictionary< std::string, fingerprint, std::less< > >;
+    using generation_dict = TreeDictionary< std::string, unsigned long, std::less< > >;
+    struct prepared_handle
+    {
+      std::string name_;
+      unsigned long lists_version_;
+      list* list_;
+      concat_entry* concat_;
+      mapped_list* mapped_;
+      unsigned long positions_version_;
+      pos* pos_;
+    };
+    struct prepared_command
+    {
+      command_list tokens_;
+      commandsAction* action_;
+      BidirectionalList< prepared_handle > handles_;
+      CommandCounters* counters_;
+      BidirectionalList< std::string >::Iterator recency_;
+    };
+    using prepared_dict = TreeDictionary< std::string, prepared_command, std::less< > >;
+    static constexpr unsigned long max_prepared = 1024;
+    static constexpr std::size_t seen_slots = 4096;
+    static constexpr unsigned long reclaim_threshold = 4096;
+
+    std::unique_ptr< OutputSink > own_out_;
+    OutputSink& out_;
+    list_dict lists_;
+    lazy_dict lazy_lists_;
+    BidirectionalList< MappedFile > mapped_files_;
+    mapped_dict mapped_lists_;
+    BidirectionalList< Snapshot > mapped_snapshots_;
+    concat_dict concat_lists_;
+    dependents_dict concat_dependents_;
+    bool lazy_concat_;
+    fingerprint_dict fingerprints_;
+    generation_dict generations_;
+    pos_dict positions_;
+    std::unique_ptr< JournalWriter > journal_;
+    cmd_dict command_dictionary_;
+    prepared_dict prepared_;
+    BidirectionalList< std::string > prepared_order_;
+    unsigned long prepared_count_;
+    std::unique_ptr< std::size_t[] > seen_lines_;
+    prepared_command* current_;
+    ScratchArena scratch_;
+    DeferredReclaimer< list > reclaimer_;
+    unsigned long lists_version_;
+    unsigned long positions_version_;
+#if S3_COMMAND_STATS
+    CommandStats stats_;
+#endif
+    cmd_dict makeCommandDictionary();
+    void execute(commandsAction*, command_list&, const accounting::Counts&);
+    prepared_handle* handleFor(const std::string&);
+    list* lookupList(const std::string&);
+    mapped_list* findMappedList(const std::string&);
+    concat_entry* findConcatList(const std::string&);
+    void materializeConcatList(const std::string&);
+    void detachDependents(const std::string&);
+    void addSources(concat_entry&, const std::string&);
+    pos* findPosition(const std::string&);
+    pos& getPosition(const std::string&);
+    void addLists(BidirectionalList< loaded_list >&&);
+    void materializeLazyLists();
+    list* findList(const std::string&);
+    list* bindList(const std::string&);
+    list& getList(const std::string&);
+    void dropList(const std::string&);
+    void touchList(const std::string&);
+    unsigned long generationOf(const std::string&);
+    void retireList(list&);
+    const fingerprint& fingerprintOf(const std::string&);
+    void setFingerprint(const std::string&, const fingerprint&);
+    template< typename F >
+    void visitList(const std::string&, F);
+    void pushPosition(const std::string&, value_t, const std::string&, const list&, list::ConstIterator);
+    template< typename List >
+    void pushPosition(const std::string&, value_t, const std::string&, const List&, typename List::ConstIterator);
+    pos& setPosition(const std::string&, pos&&);
+    void rebindPosition(pos&);
+    bool refreshPosition(pos&);
+    void resolvePositions(const std::string&);
+    void replaceValues(const std::string&, value_t, value_t);
+    void replaceByList(const std::string&, value_t, const std::string&);
+    void removeValues(const std::string&, value_t);
+    void removeByList(const std::string&, const std::string&);
+    void concatLists(const std::string&, command_list::ConstIterator, command_list::ConstIterator);
+    void applyRecord(const JournalRecord&);
+    void journalList(const std::string&);
+    void doPrintCommand(command_list_iterator, command_list_iterator);
+    void doReplaceCommand(command_list_iterator, command_list_iterator);
+    void doRemoveCommand(command_list_iterator, command_list_iterator);
+    void doConcatCommand(command_list_iterator, command_list_iterator);
+    void doEqualCommand(command_list_iterator, command_list_iterator);
+    void doBeginCommand(command_list_iterator, command_list_iterator);
+    void doEndCommand(command_list_iterator, command_list_iterator);
+    void doMismatchCommand(command_list_iterator, command_list_iterator);
+    void doPrintPosCommand(command_list_iterator, command_list_iterator);
+    void doSwapCommand(command_list_iterator, command_list_iterator);
+    void doFindCommand(command_list_iterator, command_list_iterator);
+    void doRotateCommand(command_list_iterator, command_list_iterator);
+    void doSwapRangesCommand(command_list_iterator, command_list_iterator);
+    void rotateRanges(command_list_iterator, command_list_iterator, bool);
+    template< typename Predicate >
+    void repointBystanders(const pos&, Predicate);
+    void doSearchCommand(command_list_iterator, command_list_iterator);
+    void doSaveCommand(command_list_iterator, command_list_iterator);
+    void doLoadCommand(command_list_iterator, command_list_iterator);
+    void doMapCommand(command_list_iterator, command_list_iterator);
+#if S3_COMMAND_STATS
+    void doStatsCommand(command_list_iterator, command_list_iterator);
+#endif
+  };
+
+  template< typename F >
+  void CommandMaker::visitList(const std::string& name, F f)
+  {
+    list* found = findList(name);
+    if (found)
+    {
+      f(std::as_const(*found));
+      return;
+    }
+    concat_entry* concat = findConcatList(name);
+    if (concat)
+    {
+      f(std::as_const(concat->list_));
+      return;
+    }
+    mapped_list* mapped = findMappedList(name);
+    if (!mapped)
+    {
+      throw std::logic_error("no list in dict");
+    }
+    f(std::as_const(*mapped));
+  }
+}
+
+#endif
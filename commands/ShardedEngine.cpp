@@ -0,0 +1,374 @@
+#include "commands/ShardedEngine.h"
+#include <functional>
+#include <utility>
+#include "io/ListParser.h"
+
+namespace
+{
+  bool isGlobalCommand(const std::string& keyword)
+  {
+    return keyword == "save" || keyword == "load" || keyword == "map";
+  }
+
+  bool isValueArgument(const std::string& keyword, std::size_t index, const std::string& token)
+  {
+    int value = 0;
+    if (keyword == "replace")
+    {
+      return index == 1 || (index == 2 && bendryshev::tryParseNumber(token, value));
+    }
+    if (keyword == "remove")
+    {
+      return index == 1 && bendryshev::tryParseNumber(token, value);
+    }
+    if (keyword == "find")
+    {
+      return index == 2;
+    }
+    if (keyword == "search")
+    {
+      return index == 3;
+    }
+    return false;
+  }
+
+  bool bindsPosition(const std::string& keyword)
+  {
+    return keyword == "begin" || keyword == "end" || keyword == "find" || keyword == "mismatch";
+  }
+}
+
+bendryshev::ShardedEngine::Shard::Shard():
+  output_(),
+  maker_(output_),
+  mutex_(),
+  ready_(),
+  tasks_(),
+  worker_()
+{}
+
+bendryshev::ShardedEngine::ShardedEngine(OutputSink& out, unsigned shards):
+  out_(out),
+  shard_count_(shards == 0 ? 1 : shards),
+  shards_(new Shard[shard_count_]),
+  pending_(),
+  bindings_(),
+  pending_count_(0)
+{
+  for (unsigned i = 0; i < shard_count_; ++i)
+  {
+    shards_[i].maker_.setLazyConcat(false);
+  }
+}
+
+bendryshev::ShardedEngine::~ShardedEngine()
+{
+  flush();
+  for (unsigned i = 0; i < shard_count_; ++i)
+  {
+    if (shards_[i].worker_.joinable())
+    {
+      enqueue(i, nullptr);
+      shards_[i].worker_.join();
+    }
+  }
+}
+
+bendryshev::CommandMaker& bendryshev::ShardedEngine::loader()
+{
+  return shards_[0].maker_;
+}
+
+void bendryshev::ShardedEngine::start()
+{
+  redistribute(0);
+  for (unsigned i = 0; i < shard_count_; ++i)
+  {
+    shards_[i].worker_ = std::thread(&ShardedEngine::work, this, i);
+  }
+}
+
+void bendryshev::ShardedEngine::submit(command_list&& command)
+{
+#if S3_COMMAND_STATS
+  if (command.getFrontData() == "stats" && command.getSize() == 1)
+  {
+    stats().print(out_);
+    return;
+  }
+#endif
+  std::unique_ptr< Task > task = std::make_unique< Task >();
+  task->command_ = std::move(command);
+  task->global_ = false;
+  task->arrived_ = 0;
+  task->released_ = 0;
+  task->done_ = false;
+  route(*task);
+  updateBindings(*task);
+  Task* queued = task.get();
+  pending_.pushBack(std::move(task));
+  for (auto it = queued->shards_.cbegin(); it != queued->shards_.cend(); ++it)
+  {
+    enqueue(*it, queued);
+  }
+  if (++pending_count_ >= max_pending)
+  {
+    flush();
+  }
+}
+
+void bendryshev::ShardedEngine::flush()
+{
+  for (auto&& task: pending_)
+  {
+    std::unique_lock< std::mutex > lock(task->mutex_);
+    task->changed_.wait(lock, [&task]
+    {
+      return task->released_ == task->participants_;
+    });
+    out_ << task->output_;
+  }
+  pending_.clear();
+  pending_count_ = 0;
+  out_.flush();
+}
+
+#if S3_COMMAND_STATS
+bendryshev::CommandStats bendryshev::ShardedEngine::stats()
+{
+  flush();
+  CommandStats merged;
+  for (unsigned i = 0; i < shard_count_; ++i)
+  {
+    merged.merge(shards_[i].maker_.stats());
+  }
+  return merged;
+}
+#endif
+
+unsigned bendryshev::ShardedEngine::shardOf(const std::string& name) const
+{
+  return static_cast< unsigned >(std::hash< std::string >()(name) % shard_count_);
+}
+
+void bendryshev::ShardedEngine::route(Task& task)
+{
+  const std::string& keyword = task.command_.getFrontData();
+  std::unique_ptr< bool[] > involved(new bool[shard_count_]());
+  if (isGlobalCommand(keyword))
+  {
+    task.global_ = true;
+    for (unsigned i = 0; i < shard_count_; ++i)
+    {
+      involved[i] = true;
+    }
+  }
+  else
+  {
+    std::size_t index = 0;
+    auto it = task.command_.cbegin();
+    for (++it; it != task.command_.cend(); ++it, ++index)
+    {
+      if (isValueArgument(keyword, index, *it))
+      {
+        continue;
+      }
+      task.names_.pushBack(*it);
+      involved[shardOf(*it)] = true;
+      if (const std::string* bound = bindings_.lookup(*it))
+      {
+        task.names_.pushBack(*bound);
+        involved[shardOf(*bound)] = true;
+      }
+    }
+  }
+  for (unsigned i = 0; i < shard_count_; ++i)
+  {
+    if (involved[i])
+    {
+      task.shards_.pushBack(i);
+    }
+  }
+  if (task.shards_.isEmpty())
+  {
+    task.shards_.pushBack(shardOf(keyword));
+  }
+  task.participants_ = task.shards_.getSize();
+}
+
+void bendryshev::ShardedEngine::updateBindings(const Task& task)
+{
+  auto it = task.command_.cbegin();
+  const std::string& keyword = *(it++);
+  if (keyword == "load")
+  {
+    bindings_.clear();
+    return;
+  }
+  if (it == task.command_.cend())
+  {
+    return;
+  }
+  const std::string& first = *(it++);
+  if (it == task.command_.cend())
+  {
+    return;
+  }
+  const std::string& second = *it;
+  if (bindsPosition(keyword) || keyword == "search")
+  {
+    const std::string* bound = (keyword == "search") ? bindings_.lookup(second) : std::addressof(second);
+    std::string list_name = bound ? *bound : std::string();
+    bindings_.drop(first);
+    if (!list_name.empty())
+    {
+      bindings_.push(first, std::move(list_name));
+    }
+  }
+  else if (keyword == "swap" && first != second)
+  {
+    const std::string* first_bound = bindings_.lookup(first);
+    const std::string* second_bound = bindings_.lookup(second);
+    std::string first_list = first_bound ? *first_bound : std::string();
+    std::string second_list = second_bound ? *second_bound : std::string();
+    bindings_.drop(first);
+    bindings_.drop(second);
+    if (!second_list.empty())
+    {
+      bindings_.push(first, std::move(second_list));
+    }
+    if (!first_list.empty())
+    {
+      bindings_.push(second, std::move(first_list));
+    }
+  }
+}
+
+void bendryshev::ShardedEngine::enqueue(unsigned shard, Task* task)
+{
+  Shard& target = shards_[shard];
+  {
+    std::lock_guard< std::mutex > lock(target.mutex_);
+    target.tasks_.push(task);
+  }
+  target.ready_.notify_one();
+}
+
+void bendryshev::ShardedEngine::work(unsigned shard)
+{
+  Shard& self = shards_[shard];
+  for (;;)
+  {
+    Task* task = nullptr;
+    {
+      std::unique_lock< std::mutex > lock(self.mutex_);
+      self.ready_.wait(lock, [&self]
+      {
+        return !self.tasks_.isEmpty();
+      });
+      task = self.tasks_.getNext();
+      self.tasks_.drop();
+    }
+    if (!task)
+    {
+      return;
+    }
+    if (task->shards_.getFrontData() == shard)
+    {
+      coordinate(shard, *task);
+    }
+    else
+    {
+      std::unique_lock< std::mutex > lock(task->mutex_);
+      ++task->arrived_;
+      task->changed_.notify_all();
+      task->changed_.wait(lock, [task]
+      {
+        return task->done_;
+      });
+      ++task->released_;
+      task->changed_.notify_all();
+    }
+  }
+}
+
+void bendryshev::ShardedEngine::execute(unsigned shard, Task& task)
+{
+  Shard& self = shards_[shard];
+  self.maker_.doCommand(task.command_);
+  task.output_ = self.output_.str();
+  self.output_.str(std::string());
+}
+
+void bendryshev::ShardedEngine::coordinate(unsigned shard, Task& task)
+{
+  std::size_t others = task.participants_ - 1;
+  if (others != 0)
+  {
+    std::unique_lock< std::mutex > lock(task.mutex_);
+    task.changed_.wait(lock, [&task, others]
+    {
+      return task.arrived_ == others;
+    });
+  }
+  CommandMaker& maker = shards_[shard].maker_;
+  if (task.global_)
+  {
+    for (unsigned i = 0; i < shard_count_; ++i)
+    {
+      if (i != shard)
+      {
+        BidirectionalList< std::string > names = shards_[i].maker_.entryNames();
+        for (auto&& name: names)
+        {
+          shards_[i].maker_.moveEntries(name, maker);
+        }
+      }
+    }
+  }
+  else if (others != 0)
+  {
+    for (auto&& name: task.names_)
+    {
+      unsigned owner = shardOf(name);
+      if (owner != shard)
+      {
+        shards_[owner].maker_.moveEntries(name, maker);
+      }
+    }
+  }
+  execute(shard, task);
+  if (task.global_)
+  {
+    redistribute(shard);
+  }
+  else if (others != 0)
+  {
+    for (auto&& name: task.names_)
+    {
+      unsigned owner = shardOf(name);
+      if (owner != shard)
+      {
+        maker.moveEntries(name, shards_[owner].maker_);
+      }
+    }
+  }
+  std::lock_guard< std::mutex > lock(task.mutex_);
+  task.done_ = true;
+  ++task.released_;
+  task.changed_.notify_all();
+}
+
+void bendryshev::ShardedEngine::redistribute(unsigned shard)
+{
+  CommandMaker& maker = shards_[shard].maker_;
+  BidirectionalList< std::string > names = maker.entryNames();
+  for (auto&& name: names)
+  {
+    unsigned owner = shardOf(name);
+    if (owner != shard)
+    {
+      maker.moveEntries(name, shards_[owner].maker_);
+    }
+  }
+}
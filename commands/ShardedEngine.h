@@ -0,0 +1,82 @@
+#ifndef S3_SHARDEDENGINE_H
+#define S3_SHARDEDENGINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "commands/ListsCommandMaker.h"
+#include "data_structures/BidirectionalList.h"
+#include "data_structures/Queue.h"
+#include "data_structures/TreeDictionary.h"
+#include "io/OutputSink.h"
+
+namespace bendryshev
+{
+  class ShardedEngine
+  {
+  public:
+    ShardedEngine(OutputSink&, unsigned shards);
+    ShardedEngine(const ShardedEngine&) = delete;
+    ShardedEngine& operator=(const ShardedEngine&) = delete;
+    ~ShardedEngine();
+
+    CommandMaker& loader();
+    void start();
+    void submit(command_list&&);
+    void flush();
+#if S3_COMMAND_STATS
+    CommandStats stats();
+#endif
+  private:
+    static constexpr std::size_t max_pending = 4096;
+
+    struct Task
+    {
+      command_list command_;
+      BidirectionalList< std::string > names_;
+      BidirectionalList< unsigned > shards_;
+      bool global_;
+      std::string output_;
+      std::mutex mutex_;
+      std::condition_variable changed_;
+      std::size_t participants_;
+      std::size_t arrived_;
+      std::size_t released_;
+      bool done_;
+    };
+
+    struct Shard
+    {
+      Shard();
+
+      std::ostringstream output_;
+      CommandMaker maker_;
+      std::mutex mutex_;
+      std::condition_variable ready_;
+      Queue< Task* > tasks_;
+      std::thread worker_;
+    };
+
+    OutputSink& out_;
+    unsigned shard_count_;
+    std::unique_ptr< Shard[] > shards_;
+    BidirectionalList< std::unique_ptr< Task > > pending_;
+    TreeDictionary< std::string, std::string, std::less< > > bindings_;
+    std::size_t pending_count_;
+
+    unsigned shardOf(const std::string&) const;
+    void route(Task&);
+    void updateBindings(const Task&);
+    void enqueue(unsigned, Task*);
+    void work(unsigned);
+    void execute(unsigned, Task&);
+    void coordinate(unsigned, Task&);
+    void redistribute(unsigned);
+  };
+}
+
+#endif
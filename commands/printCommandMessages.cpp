@@ -1,23 +1,44 @@
-#include "printCommandMessages.h"
-#include <iostream>
-
-void bendryshev::printInvalidCommandMessage(std::ostream& out)
-{
-  out << "<INVALID COMMAND>\n";
-}
-
-void bendryshev::printEmptyCommandMessage(std::ostream& out)
-{
-  out << "<EMPTY>\n";
-}
-
-void bendryshev::printTrueMessage(std::ostream& out)
-{
-  out << "<TRUE>\n";
-}
-
-void bendryshev::printFalseMessage(std::ostream& out)
-{
-  out << "<FALSE>\n";
-}
-
+#include "printCommandMessages.h"
+#include <iostream>
+#include "io/OutputSink.h"
+
+void bendryshev::printInvalidCommandMessage(std::ostream& out)
+{
+  out << "<INVALID COMMAND>\n";
+}
+
+void bendryshev::printEmptyCommandMessage(std::ostream& out)
+{
+  out << "<EMPTY>\n";
+}
+
+void bendryshev::printTrueMessage(std::ostream& out)
+{
+  out << "<TRUE>\n";
+}
+
+void bendryshev::printFalseMessage(std::ostream& out)
+{
+  out << "<FALSE>\n";
+}
+
+
+void bendryshev::printInvalidCommandMessage(OutputSink& out)
+{
+  out << "<INVALID COMMAND>\n";
+}
+
+void bendryshev::printEmptyCommandMessage(OutputSink& out)
+{
+  out << "<EMPTY>\n";
+}
+
+void bendryshev::printTrueMessage(OutputSink& out)
+{
+  out << "<TRUE>\n";
+}
+
+void bendryshev::printFalseMessage(OutputSink& out)
+{
+  out << "<FALSE>\n";
+}
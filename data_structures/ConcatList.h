@@ -0,0 +1,213 @@
+#ifndef S3_CONCATLIST_H
+#define S3_CONCATLIST_H
+
+#include <cassert>
+#include "data_structures/BidirectionalList.h"
+
+namespace bendryshev
+{
+  template< typename T >
+  class ConcatList
+  {
+    using list_iterator = typename BidirectionalList< T >::ConstIterator;
+    struct Segment
+    {
+      list_iterator first_;
+      list_iterator last_;
+      const T* data_first_;
+      const T* data_last_;
+    };
+    using segment_iterator = typename BidirectionalList< Segment >::ConstIterator;
+  public:
+    void append(const BidirectionalList< T >&);
+    void append(const T*, const T*);
+    void append(const ConcatList< T >&);
+
+    bool isEmpty() const noexcept;
+    unsigned long getSize() const noexcept;
+
+    struct ConstIterator
+    {
+      friend class ConcatList< T >;
+
+      using this_t = bendryshev::ConcatList< T >::ConstIterator;
+      ConstIterator() = default;
+      ConstIterator(const this_t&) = default;
+      ~ConstIterator() = default;
+      this_t& operator=(const this_t&) = default;
+      this_t& operator++();
+      this_t operator++(int);
+      const T& operator*() const;
+      const T* operator->() const;
+      bool operator!=(const this_t&) const;
+      bool operator==(const this_t&) const;
+    private:
+      segment_iterator segment_;
+      segment_iterator segments_end_;
+      list_iterator item_;
+      const T* data_;
+      ConstIterator(segment_iterator, segment_iterator);
+      void enterSegment();
+    };
+
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+  private:
+    BidirectionalList< Segment > segments_;
+
+    static list_iterator nullIterator() noexcept;
+  };
+
+  template< typename T >
+  ConcatList< T >::ConstIterator::ConstIterator(segment_iterator segment, segment_iterator segments_end):
+    segment_(segment),
+    segments_end_(segments_end),
+    item_(nullIterator()),
+    data_(nullptr)
+  {
+    enterSegment();
+  }
+
+  template< typename T >
+  void ConcatList< T >::ConstIterator::enterSegment()
+  {
+    if (segment_ != segments_end_)
+    {
+      item_ = segment_->first_;
+      data_ = segment_->data_first_;
+    }
+    else
+    {
+      item_ = nullIterator();
+      data_ = nullptr;
+    }
+  }
+
+  template< typename T >
+  typename ConcatList< T >::ConstIterator::this_t& ConcatList< T >::ConstIterator::operator++()
+  {
+    assert(segment_ != segments_end_);
+    bool segment_done = false;
+    if (data_)
+    {
+      segment_done = ++data_ == segment_->data_last_;
+    }
+    else
+    {
+      segment_done = ++item_ == segment_->last_;
+    }
+    if (segment_done)
+    {
+      ++segment_;
+      enterSegment();
+    }
+    return *this;
+  }
+
+  template< typename T >
+  typename ConcatList< T >::ConstIterator::this_t ConcatList< T >::ConstIterator::operator++(int)
+  {
+    this_t result(*this);
+    ++(*this);
+    return result;
+  }
+
+  template< typename T >
+  const T& ConcatList< T >::ConstIterator::operator*() const
+  {
+    assert(segment_ != segments_end_);
+    return data_ ? *data_ : *item_;
+  }
+
+  template< typename T >
+  const T* ConcatList< T >::ConstIterator::operator->() const
+  {
+    return std::addressof(**this);
+  }
+
+  template< typename T >
+  bool ConcatList< T >::ConstIterator::operator!=(const this_t& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  template< typename T >
+  bool ConcatList< T >::ConstIterator::operator==(const this_t& rhs) const
+  {
+    return segment_ == rhs.segment_ && item_ == rhs.item_ && data_ == rhs.data_;
+  }
+
+  template< typename T >
+  typename ConcatList< T >::list_iterator ConcatList< T >::nullIterator() noexcept
+  {
+    return BidirectionalList< T >().cend();
+  }
+
+  template< typename T >
+  void ConcatList< T >::append(const BidirectionalList< T >& source)
+  {
+    if (!source.isEmpty())
+    {
+      segments_.pushBack(Segment { source.cbegin(), source.cend(), nullptr, nullptr });
+    }
+  }
+
+  template< typename T >
+  void ConcatList< T >::append(const T* first, const T* last)
+  {
+    if (first != last)
+    {
+      segments_.pushBack(Segment { nullIterator(), nullIterator(), first, last });
+    }
+  }
+
+  template< typename T >
+  void ConcatList< T >::append(const ConcatList< T >& source)
+  {
+    for (auto it = source.segments_.cbegin(); it != source.segments_.cend(); ++it)
+    {
+      segments_.pushBack(*it);
+    }
+  }
+
+  template< typename T >
+  bool ConcatList< T >::isEmpty() const noexcept
+  {
+    return segments_.isEmpty();
+  }
+
+  template< typename T >
+  unsigned long ConcatList< T >::getSize() const noexcept
+  {
+    unsigned long size = 0;
+    for (auto it = segments_.cbegin(); it != segments_.cend(); ++it)
+    {
+      if (it->data_first_)
+      {
+        size += static_cast< unsigned long >(it->data_last_ - it->data_first_);
+      }
+      else
+      {
+        for (auto item = it->first_; item != it->last_; ++item)
+        {
+          ++size;
+        }
+      }
+    }
+    return size;
+  }
+
+  template< typename T >
+  typename ConcatList< T >::ConstIterator ConcatList< T >::cbegin() const noexcept
+  {
+    return ConstIterator(segments_.cbegin(), segments_.cend());
+  }
+
+  template< typename T >
+  typename ConcatList< T >::ConstIterator ConcatList< T >::cend() const noexcept
+  {
+    return ConstIterator(segments_.cend(), segments_.cend());
+  }
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef S3_CONTAINERACCOUNTING_H
+#define S3_CONTAINERACCOUNTING_H
+
+#include <cstddef>
+
+#ifndef S3_CONTAINER_ACCOUNTING
+#define S3_CONTAINER_ACCOUNTING 0
+#endif
+
+namespace bendryshev
+{
+  namespace accounting
+  {
+    struct Counts
+    {
+      unsigned long allocations_;
+      unsigned long frees_;
+      unsigned long bytes_;
+      unsigned long hops_;
+    };
+
+#if S3_CONTAINER_ACCOUNTING
+    inline thread_local Counts current = { 0, 0, 0, 0 };
+
+    inline Counts snapshot() noexcept
+    {
+      return current;
+    }
+
+    inline void allocated(std::size_t bytes) noexcept
+    {
+      ++current.allocations_;
+      current.bytes_ += bytes;
+    }
+
+    inline void freed(std::size_t) noexcept
+    {
+      ++current.frees_;
+    }
+
+    inline void hop() noexcept
+    {
+      ++current.hops_;
+    }
+#else
+    inline Counts snapshot() noexcept
+    {
+      return Counts { 0, 0, 0, 0 };
+    }
+
+    inline void allocated(std::size_t) noexcept
+    {}
+
+    inline void freed(std::size_t) noexcept
+    {}
+
+    inline void hop() noexcept
+    {}
+#endif
+
+    inline Counts since(const Counts& before) noexcept
+    {
+      Counts now = snapshot();
+      return Counts {
+        now.allocations_ - before.allocations_,
+        now.frees_ - before.frees_,
+        now.bytes_ - before.bytes_,
+        now.hops_ - before.hops_
+      };
+    }
+  }
+}
+
+#endif
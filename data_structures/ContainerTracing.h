@@ -0,0 +1,63 @@
+#ifndef S3_CONTAINERTRACING_H
+#define S3_CONTAINERTRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef S3_TRACING
+#define S3_TRACING 1
+#endif
+
+namespace bendryshev
+{
+  namespace container_tracing
+  {
+    using Recorder = void (*)(const char*, std::size_t, std::uint64_t, std::uint64_t) noexcept;
+
+    // Installed by the trace recorder while tracing runs; containers used without it only pay for a null check.
+    inline std::atomic< Recorder > recorder(nullptr);
+
+    inline std::uint64_t now() noexcept
+    {
+      auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+      return static_cast< std::uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(since_epoch).count());
+    }
+
+    class Span
+    {
+    public:
+      explicit Span(const char* name) noexcept:
+        name_(name),
+        recorder_(recorder.load(std::memory_order_relaxed)),
+        start_(recorder_ ? now() : 0)
+      {}
+
+      Span(const Span&) = delete;
+      Span& operator=(const Span&) = delete;
+
+      ~Span()
+      {
+        if (recorder_)
+        {
+          recorder_(name_, 0, start_, now());
+        }
+      }
+    private:
+      const char* name_;
+      Recorder recorder_;
+      std::uint64_t start_;
+    };
+  }
+}
+
+#define S3_CONTAINER_SPAN_CONCAT_IMPL(a, b) a##b
+#define S3_CONTAINER_SPAN_CONCAT(a, b) S3_CONTAINER_SPAN_CONCAT_IMPL(a, b)
+#if S3_TRACING
+#define S3_CONTAINER_SPAN(name) bendryshev::container_tracing::Span S3_CONTAINER_SPAN_CONCAT(s3_container_span_, __LINE__)(name)
+#else
+#define S3_CONTAINER_SPAN(name) static_cast< void >(0)
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef S3_DEFERREDRECLAIMER_H
+#define S3_DEFERREDRECLAIMER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "data_structures/RingBuffer.h"
+#include "data_structures/ContainerTracing.h"
+
+namespace bendryshev
+{
+  template< typename List >
+  class DeferredReclaimer
+  {
+  public:
+    DeferredReclaimer();
+    DeferredReclaimer(const DeferredReclaimer< List >&) = delete;
+    DeferredReclaimer< List >& operator=(const DeferredReclaimer< List >&) = delete;
+    ~DeferredReclaimer();
+
+    void retire(List&&);
+  private:
+    RingBuffer< List > pending_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_;
+    std::thread worker_;
+
+    void work();
+  };
+
+  template< typename List >
+  DeferredReclaimer< List >::DeferredReclaimer():
+    pending_(),
+    mutex_(),
+    ready_(),
+    stopping_(false),
+    worker_()
+  {}
+
+  template< typename List >
+  DeferredReclaimer< List >::~DeferredReclaimer()
+  {
+    if (worker_.joinable())
+    {
+      {
+        std::lock_guard< std::mutex > lock(mutex_);
+        stopping_ = true;
+      }
+      ready_.notify_one();
+      worker_.join();
+    }
+  }
+
+  template< typename List >
+  void DeferredReclaimer< List >::retire(List&& values)
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      pending_.pushBack(std::move(values));
+    }
+    // The worker is started on the first retire, so runs that never drop a long list stay single-threaded.
+    if (!worker_.joinable())
+    {
+      worker_ = std::thread(&DeferredReclaimer< List >::work, this);
+    }
+    ready_.notify_one();
+  }
+
+  template< typename List >
+  void DeferredReclaimer< List >::work()
+  {
+    for (;;)
+    {
+      List values;
+      {
+        std::unique_lock< std::mutex > lock(mutex_);
+        ready_.wait(lock, [this]
+        {
+          return stopping_ || !pending_.isEmpty();
+        });
+        if (pending_.isEmpty())
+        {
+          return;
+        }
+        values = std::move(pending_.front());
+        pending_.popFront();
+      }
+      S3_CONTAINER_SPAN("reclaim");
+      values.clear();
+    }
+  }
+}
+
+#endif
@@ -1,65 +1,112 @@
-#ifndef S4_DEQUEUE_H
-#define S4_DEQUEUE_H
-
-#include "data_structures/BidirectionalList.h"
-
-namespace bendryshev
-{
-  template< typename T >
-  class Dequeue
-  {
-  public:
-
-    void push(const T& rhs);
-    const T& getTop() const;
-    const T& getFront() const;
-    void drop();
-    bool isEmpty() const;
-
-  private:
-    BidirectionalList< T > items_;
-  };
-
-  template< typename T >
-  void bendryshev::Dequeue< T >::push(const T& rhs)
-  {
-    items_.pushFront(rhs);
-  }
-
-  template< typename T >
-  const T& bendryshev::Dequeue< T >::getTop() const
-  {
-    if (items_.isEmpty())
-    {
-      throw std::logic_error("Stack is empty");
-    }
-    return items_.getFrontData();
-  }
-
-  template< typename T >
-  void bendryshev::Dequeue< T >::drop()
-  {
-    if (isEmpty())
-    {
-      throw std::logic_error("Stack is empty");
-    }
-    items_.popFront();
-  }
-
-  template< typename T >
-  bool bendryshev::Dequeue< T >::isEmpty() const
-  {
-    return items_.isEmpty();
-  }
-
-  template< typename T >
-  const T& Dequeue< T >::getFront() const
-  {
-    if (items_.isEmpty())
-    {
-      throw std::logic_error("Stack is empty");
-    }
-    return items_.getBackData();
-  }
-}
-#endif
+#ifndef S4_DEQUEUE_H
+#define S4_DEQUEUE_H
+
+#include <stdexcept>
+#include "data_structures/RingBuffer.h"
+
+namespace bendryshev
+{
+  template< typename T >
+  class Dequeue
+  {
+  public:
+
+    void pushFront(const T& rhs);
+    void pushBack(const T& rhs);
+    const T& getFront() const;
+    const T& getBack() const;
+    void dropFront();
+    void dropBack();
+    bool isEmpty() const;
+    std::size_t getSize() const;
+
+    void push(const T& rhs);
+    const T& getTop() const;
+    void drop();
+
+  private:
+    RingBuffer< T > items_;
+
+    void checkNotEmpty() const;
+  };
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::pushFront(const T& rhs)
+  {
+    items_.pushFront(rhs);
+  }
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::pushBack(const T& rhs)
+  {
+    items_.pushBack(rhs);
+  }
+
+  template< typename T >
+  const T& bendryshev::Dequeue< T >::getFront() const
+  {
+    checkNotEmpty();
+    return items_.front();
+  }
+
+  template< typename T >
+  const T& bendryshev::Dequeue< T >::getBack() const
+  {
+    checkNotEmpty();
+    return items_.back();
+  }
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::dropFront()
+  {
+    checkNotEmpty();
+    items_.popFront();
+  }
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::dropBack()
+  {
+    checkNotEmpty();
+    items_.popBack();
+  }
+
+  template< typename T >
+  bool bendryshev::Dequeue< T >::isEmpty() const
+  {
+    return items_.isEmpty();
+  }
+
+  template< typename T >
+  std::size_t bendryshev::Dequeue< T >::getSize() const
+  {
+    return items_.getSize();
+  }
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::push(const T& rhs)
+  {
+    pushBack(rhs);
+  }
+
+  template< typename T >
+  const T& bendryshev::Dequeue< T >::getTop() const
+  {
+    return getBack();
+  }
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::drop()
+  {
+    dropBack();
+  }
+
+  template< typename T >
+  void bendryshev::Dequeue< T >::checkNotEmpty() const
+  {
+    if (items_.isEmpty())
+    {
+      throw std::logic_error("Dequeue is empty");
+    }
+  }
+}
+#endif
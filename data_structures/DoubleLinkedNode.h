@@ -1,17 +1,33 @@
-#ifndef S3_DOUBLELINKEDNODE_H
-#define S3_DOUBLELINKEDNODE_H
-
-namespace bendryshev
-{
-  namespace detail
-  {
-    template< typename T >
-    struct DoubleLinkedNode
-    {
-      T data_;
-      DoubleLinkedNode< T >* pPrev_;
-      DoubleLinkedNode< T >* pNext_;
-    };
-  }
-}
-#endif
+#ifndef S3_DOUBLELINKEDNODE_H
+#define S3_DOUBLELINKEDNODE_H
+
+#include "data_structures/ContainerAccounting.h"
+
+namespace bendryshev
+{
+  namespace detail
+  {
+    template< typename T >
+    struct DoubleLinkedNode
+    {
+      T data_;
+      DoubleLinkedNode< T >* pPrev_;
+      DoubleLinkedNode< T >* pNext_;
+#if S3_CONTAINER_ACCOUNTING
+      static void* operator new(std::size_t size)
+      {
+        void* memory = ::operator new(size);
+        accounting::allocated(size);
+        return memory;
+      }
+
+      static void operator delete(void* memory, std::size_t size) noexcept
+      {
+        accounting::freed(size);
+        ::operator delete(memory);
+      }
+#endif
+    };
+  }
+}
+#endif
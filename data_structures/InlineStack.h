@@ -0,0 +1,83 @@
+#ifndef S3_INLINESTACK_H
+#define S3_INLINESTACK_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include "data_structures/RingBuffer.h"
+
+namespace bendryshev
+{
+  template< typename T, std::size_t Capacity >
+  class InlineStack
+  {
+    static_assert(std::is_trivially_copyable< T >::value, "InlineStack keeps plain values such as node pointers");
+  public:
+    InlineStack() noexcept;
+    InlineStack(const InlineStack< T, Capacity >&) = delete;
+    InlineStack< T, Capacity >& operator=(const InlineStack< T, Capacity >&) = delete;
+
+    void push(T);
+    T getTop() const noexcept;
+    void drop() noexcept;
+    bool isEmpty() const noexcept;
+    std::size_t getSize() const noexcept;
+  private:
+    T items_[Capacity];
+    std::size_t size_;
+    RingBuffer< T > overflow_;
+  };
+
+  template< typename T, std::size_t Capacity >
+  InlineStack< T, Capacity >::InlineStack() noexcept:
+    size_(0)
+  {}
+
+  template< typename T, std::size_t Capacity >
+  void InlineStack< T, Capacity >::push(T value)
+  {
+    if (size_ < Capacity)
+    {
+      items_[size_++] = value;
+    }
+    else
+    {
+      overflow_.pushBack(value);
+    }
+  }
+
+  template< typename T, std::size_t Capacity >
+  T InlineStack< T, Capacity >::getTop() const noexcept
+  {
+    assert(!isEmpty());
+    return overflow_.isEmpty() ? items_[size_ - 1] : overflow_.back();
+  }
+
+  template< typename T, std::size_t Capacity >
+  void InlineStack< T, Capacity >::drop() noexcept
+  {
+    assert(!isEmpty());
+    if (overflow_.isEmpty())
+    {
+      --size_;
+    }
+    else
+    {
+      overflow_.popBack();
+    }
+  }
+
+  template< typename T, std::size_t Capacity >
+  bool InlineStack< T, Capacity >::isEmpty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  template< typename T, std::size_t Capacity >
+  std::size_t InlineStack< T, Capacity >::getSize() const noexcept
+  {
+    return size_ + overflow_.getSize();
+  }
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef S3_LISTFINGERPRINT_H
+#define S3_LISTFINGERPRINT_H
+
+#include <cstdint>
+
+namespace bendryshev
+{
+  template< typename T >
+  class ListFingerprint
+  {
+  public:
+    ListFingerprint() noexcept;
+    template< typename List >
+    static ListFingerprint< T > of(const List&);
+
+    void append(const T&) noexcept;
+    void append(const ListFingerprint< T >&) noexcept;
+    unsigned long getSize() const noexcept;
+
+    bool operator==(const ListFingerprint< T >&) const noexcept;
+    bool operator!=(const ListFingerprint< T >&) const noexcept;
+  private:
+    static constexpr std::uint64_t base = 0x100000001b3ULL;
+    static constexpr std::uint64_t mix = 0x9e3779b97f4a7c15ULL;
+
+    std::uint64_t hash_;
+    std::uint64_t power_;
+    unsigned long size_;
+  };
+
+  template< typename T >
+  ListFingerprint< T >::ListFingerprint() noexcept:
+    hash_(0),
+    power_(1),
+    size_(0)
+  {}
+
+  template< typename T >
+  template< typename List >
+  ListFingerprint< T > ListFingerprint< T >::of(const List& list)
+  {
+    ListFingerprint< T > result;
+    for (auto it = list.cbegin(); it != list.cend(); ++it)
+    {
+      result.append(*it);
+    }
+    return result;
+  }
+
+  template< typename T >
+  void ListFingerprint< T >::append(const T& value) noexcept
+  {
+    hash_ = hash_ * base + (static_cast< std::uint64_t >(value) * mix + 1);
+    power_ *= base;
+    ++size_;
+  }
+
+  template< typename T >
+  void ListFingerprint< T >::append(const ListFingerprint< T >& rhs) noexcept
+  {
+    hash_ = hash_ * rhs.power_ + rhs.hash_;
+    power_ *= rhs.power_;
+    size_ += rhs.size_;
+  }
+
+  template< typename T >
+  unsigned long ListFingerprint< T >::getSize() const noexcept
+  {
+    return size_;
+  }
+
+  template< typename T >
+  bool ListFingerprint< T >::operator==(const ListFingerprint< T >& rhs) const noexcept
+  {
+    return size_ == rhs.size_ && hash_ == rhs.hash_;
+  }
+
+  template< typename T >
+  bool ListFingerprint< T >::operator!=(const ListFingerprint< T >& rhs) const noexcept
+  {
+    return !(*this == rhs);
+  }
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef S3_MAPPEDLIST_H
+#define S3_MAPPEDLIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+namespace bendryshev
+{
+  template< typename T >
+  class MappedList
+  {
+  public:
+    MappedList() noexcept;
+    MappedList(const T*, const T*) noexcept;
+
+    bool isEmpty() const noexcept;
+    unsigned long getSize() const noexcept;
+    const T& getFrontData() const;
+    const T& getBackData() const;
+    const T* data() const noexcept;
+
+    struct ConstIterator
+    {
+      friend class MappedList< T >;
+
+      using this_t = bendryshev::MappedList< T >::ConstIterator;
+      ConstIterator() = default;
+      ConstIterator(const this_t&) = default;
+      ~ConstIterator() = default;
+      this_t& operator=(const this_t&) = default;
+      this_t& operator++();
+      this_t operator--();
+      this_t operator++(int);
+      this_t operator--(int);
+      const T& operator*() const;
+      const T* operator->() const;
+      bool operator!=(const this_t&) const;
+      bool operator==(const this_t&) const;
+    private:
+      const T* item_;
+      explicit ConstIterator(const T*);
+    };
+
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+  private:
+    const T* first_;
+    const T* last_;
+  };
+
+  template< typename T >
+  MappedList< T >::ConstIterator::ConstIterator(const T* item):
+    item_(item)
+  {}
+
+  template< typename T >
+  typename MappedList< T >::ConstIterator::this_t& MappedList< T >::ConstIterator::operator++()
+  {
+    assert(item_ != nullptr);
+    ++item_;
+    return *this;
+  }
+
+  template< typename T >
+  typename MappedList< T >::ConstIterator::this_t MappedList< T >::ConstIterator::operator--()
+  {
+    assert(item_ != nullptr);
+    --item_;
+    return *this;
+  }
+
+  template< typename T >
+  typename MappedList< T >::ConstIterator::this_t MappedList< T >::ConstIterator::operator++(int)
+  {
+    this_t result(*this);
+    ++(*this);
+    return result;
+  }
+
+  template< typename T >
+  typename MappedList< T >::ConstIterator::this_t MappedList< T >::ConstIterator::operator--(int)
+  {
+    this_t result(*this);
+    --(*this);
+    return result;
+  }
+
+  template< typename T >
+  const T& MappedList< T >::ConstIterator::operator*() const
+  {
+    assert(item_ != nullptr);
+    return *item_;
+  }
+
+  template< typename T >
+  const T* MappedList< T >::ConstIterator::operator->() const
+  {
+    assert(item_ != nullptr);
+    return item_;
+  }
+
+  template< typename T >
+  bool MappedList< T >::ConstIterator::operator!=(const this_t& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  template< typename T >
+  bool MappedList< T >::ConstIterator::operator==(const this_t& rhs) const
+  {
+    return item_ == rhs.item_;
+  }
+
+  template< typename T >
+  MappedList< T >::MappedList() noexcept:
+    first_(nullptr),
+    last_(nullptr)
+  {}
+
+  template< typename T >
+  MappedList< T >::MappedList(const T* first, const T* last) noexcept:
+    first_(first),
+    last_(last)
+  {}
+
+  template< typename T >
+  bool MappedList< T >::isEmpty() const noexcept
+  {
+    return first_ == last_;
+  }
+
+  template< typename T >
+  unsigned long MappedList< T >::getSize() const noexcept
+  {
+    return static_cast< unsigned long >(last_ - first_);
+  }
+
+  template< typename T >
+  const T& MappedList< T >::getFrontData() const
+  {
+    if (isEmpty())
+    {
+      throw std::logic_error("List is empty");
+    }
+    return *first_;
+  }
+
+  template< typename T >
+  const T& MappedList< T >::getBackData() const
+  {
+    if (isEmpty())
+    {
+      throw std::logic_error("List is empty");
+    }
+    return *(last_ - 1);
+  }
+
+  template< typename T >
+  const T* MappedList< T >::data() const noexcept
+  {
+    return first_;
+  }
+
+  template< typename T >
+  typename MappedList< T >::ConstIterator MappedList< T >::cbegin() const noexcept
+  {
+    return ConstIterator(first_);
+  }
+
+  template< typename T >
+  typename MappedList< T >::ConstIterator MappedList< T >::cend() const noexcept
+  {
+    return ConstIterator(last_);
+  }
+}
+
+#endif
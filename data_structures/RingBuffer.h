@@ -0,0 +1,339 @@
+#ifndef S3_RINGBUFFER_H
+#define S3_RINGBUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include "data_structures/ContainerAccounting.h"
+
+namespace bendryshev
+{
+  template< typename T >
+  class RingBuffer
+  {
+  public:
+    RingBuffer() noexcept;
+    RingBuffer(const RingBuffer< T >&);
+    RingBuffer(RingBuffer< T >&&) noexcept;
+    ~RingBuffer();
+
+    RingBuffer< T >& operator=(const RingBuffer< T >&);
+    RingBuffer< T >& operator=(RingBuffer< T >&&) noexcept;
+
+    void swap(RingBuffer< T >&) noexcept;
+    void clear() noexcept;
+    void pushBack(const T&);
+    void pushBack(T&&);
+    void pushFront(const T&);
+    void pushFront(T&&);
+    void popBack() noexcept;
+    void popFront() noexcept;
+    T& front() noexcept;
+    const T& front() const noexcept;
+    T& back() noexcept;
+    const T& back() const noexcept;
+    T& operator[](std::size_t) noexcept;
+    const T& operator[](std::size_t) const noexcept;
+    bool isEmpty() const noexcept;
+    std::size_t getSize() const noexcept;
+    std::size_t getCapacity() const noexcept;
+  private:
+    static constexpr std::size_t min_capacity = 8;
+
+    T* data_;
+    std::size_t capacity_;
+    std::size_t head_;
+    std::size_t size_;
+
+    std::size_t slot(std::size_t index) const noexcept;
+    T* allocate(std::size_t);
+    void deallocate(T*, std::size_t) noexcept;
+    void reserveFor(std::size_t);
+    template< typename U >
+    void emplaceBack(U&&);
+    template< typename U >
+    void emplaceFront(U&&);
+  };
+
+  template< typename T >
+  RingBuffer< T >::RingBuffer() noexcept:
+    data_(nullptr),
+    capacity_(0),
+    head_(0),
+    size_(0)
+  {}
+
+  template< typename T >
+  RingBuffer< T >::RingBuffer(const RingBuffer< T >& rhs):
+    RingBuffer()
+  {
+    reserveFor(rhs.size_);
+    for (std::size_t i = 0; i < rhs.size_; ++i)
+    {
+      new (data_ + i) T(rhs[i]);
+      ++size_;
+    }
+  }
+
+  template< typename T >
+  RingBuffer< T >::RingBuffer(RingBuffer< T >&& rhs) noexcept:
+    RingBuffer()
+  {
+    swap(rhs);
+  }
+
+  template< typename T >
+  RingBuffer< T >::~RingBuffer()
+  {
+    clear();
+    deallocate(data_, capacity_);
+  }
+
+  template< typename T >
+  RingBuffer< T >& RingBuffer< T >::operator=(const RingBuffer< T >& rhs)
+  {
+    if (this != std::addressof(rhs))
+    {
+      RingBuffer< T > temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< typename T >
+  RingBuffer< T >& RingBuffer< T >::operator=(RingBuffer< T >&& rhs) noexcept
+  {
+    if (this != std::addressof(rhs))
+    {
+      RingBuffer< T > temp(std::move(rhs));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< typename T >
+  void RingBuffer< T >::swap(RingBuffer< T >& rhs) noexcept
+  {
+    std::swap(data_, rhs.data_);
+    std::swap(capacity_, rhs.capacity_);
+    std::swap(head_, rhs.head_);
+    std::swap(size_, rhs.size_);
+  }
+
+  template< typename T >
+  void RingBuffer< T >::clear() noexcept
+  {
+    while (size_ != 0)
+    {
+      popBack();
+    }
+    head_ = 0;
+  }
+
+  template< typename T >
+  void RingBuffer< T >::pushBack(const T& value)
+  {
+    emplaceBack(value);
+  }
+
+  template< typename T >
+  void RingBuffer< T >::pushBack(T&& value)
+  {
+    emplaceBack(std::move(value));
+  }
+
+  template< typename T >
+  void RingBuffer< T >::pushFront(const T& value)
+  {
+    emplaceFront(value);
+  }
+
+  template< typename T >
+  void RingBuffer< T >::pushFront(T&& value)
+  {
+    emplaceFront(std::move(value));
+  }
+
+  template< typename T >
+  void RingBuffer< T >::popBack() noexcept
+  {
+    assert(size_ != 0);
+    data_[slot(size_ - 1)].~T();
+    --size_;
+  }
+
+  template< typename T >
+  void RingBuffer< T >::popFront() noexcept
+  {
+    assert(size_ != 0);
+    data_[head_].~T();
+    head_ = slot(1);
+    --size_;
+  }
+
+  template< typename T >
+  T& RingBuffer< T >::front() noexcept
+  {
+    assert(size_ != 0);
+    return data_[head_];
+  }
+
+  template< typename T >
+  const T& RingBuffer< T >::front() const noexcept
+  {
+    assert(size_ != 0);
+    return data_[head_];
+  }
+
+  template< typename T >
+  T& RingBuffer< T >::back() noexcept
+  {
+    assert(size_ != 0);
+    return data_[slot(size_ - 1)];
+  }
+
+  template< typename T >
+  const T& RingBuffer< T >::back() const noexcept
+  {
+    assert(size_ != 0);
+    return data_[slot(size_ - 1)];
+  }
+
+  template< typename T >
+  T& RingBuffer< T >::operator[](std::size_t index) noexcept
+  {
+    assert(index < size_);
+    return data_[slot(index)];
+  }
+
+  template< typename T >
+  const T& RingBuffer< T >::operator[](std::size_t index) const noexcept
+  {
+    assert(index < size_);
+    return data_[slot(index)];
+  }
+
+  template< typename T >
+  bool RingBuffer< T >::isEmpty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  template< typename T >
+  std::size_t RingBuffer< T >::getSize() const noexcept
+  {
+    return size_;
+  }
+
+  template< typename T >
+  std::size_t RingBuffer< T >::getCapacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  template< typename T >
+  std::size_t RingBuffer< T >::slot(std::size_t index) const noexcept
+  {
+    return (head_ + index) & (capacity_ - 1);
+  }
+
+  template< typename T >
+  T* RingBuffer< T >::allocate(std::size_t capacity)
+  {
+    T* data = std::allocator< T >().allocate(capacity);
+    accounting::allocated(capacity * sizeof(T));
+    return data;
+  }
+
+  template< typename T >
+  void RingBuffer< T >::deallocate(T* data, std::size_t capacity) noexcept
+  {
+    if (data)
+    {
+      accounting::freed(capacity * sizeof(T));
+      std::allocator< T >().deallocate(data, capacity);
+    }
+  }
+
+  template< typename T >
+  void RingBuffer< T >::reserveFor(std::size_t size)
+  {
+    if (size <= capacity_)
+    {
+      return;
+    }
+    std::size_t capacity = capacity_ == 0 ? min_capacity : capacity_;
+    while (capacity < size)
+    {
+      capacity *= 2;
+    }
+    T* data = allocate(capacity);
+    std::size_t moved = 0;
+    try
+    {
+      for (; moved < size_; ++moved)
+      {
+        new (data + moved) T(std::move_if_noexcept(data_[slot(moved)]));
+      }
+    }
+    catch (...)
+    {
+      while (moved != 0)
+      {
+        data[--moved].~T();
+      }
+      deallocate(data, capacity);
+      throw;
+    }
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      data_[slot(i)].~T();
+    }
+    deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = capacity;
+    head_ = 0;
+  }
+
+  template< typename T >
+  template< typename U >
+  void RingBuffer< T >::emplaceBack(U&& value)
+  {
+    if (size_ == capacity_)
+    {
+      T copy(std::forward< U >(value));
+      reserveFor(size_ + 1);
+      new (data_ + slot(size_)) T(std::move(copy));
+    }
+    else
+    {
+      new (data_ + slot(size_)) T(std::forward< U >(value));
+    }
+    ++size_;
+  }
+
+  template< typename T >
+  template< typename U >
+  void RingBuffer< T >::emplaceFront(U&& value)
+  {
+    if (size_ == capacity_)
+    {
+      T copy(std::forward< U >(value));
+      reserveFor(size_ + 1);
+      std::size_t first = slot(capacity_ - 1);
+      new (data_ + first) T(std::move(copy));
+      head_ = first;
+    }
+    else
+    {
+      std::size_t first = slot(capacity_ - 1);
+      new (data_ + first) T(std::forward< U >(value));
+      head_ = first;
+    }
+    ++size_;
+  }
+}
+
+#endif
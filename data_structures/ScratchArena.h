@@ -0,0 +1,116 @@
+#ifndef S3_SCRATCHARENA_H
+#define S3_SCRATCHARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include "data_structures/ContainerAccounting.h"
+
+namespace bendryshev
+{
+  class ScratchArena
+  {
+  public:
+    static constexpr std::size_t default_capacity = 1 << 14;
+
+    explicit ScratchArena(std::size_t capacity = default_capacity);
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    ~ScratchArena();
+
+    std::pmr::memory_resource* resource() noexcept;
+    template< typename T >
+    std::pmr::polymorphic_allocator< T > allocator() noexcept;
+    void reset();
+    std::size_t getCapacity() const noexcept;
+  private:
+    class Overflow: public std::pmr::memory_resource
+    {
+    public:
+      std::size_t requested_ = 0;
+    private:
+      void* do_allocate(std::size_t, std::size_t) override;
+      void do_deallocate(void*, std::size_t, std::size_t) override;
+      bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+    };
+
+    std::unique_ptr< std::byte[] > buffer_;
+    std::size_t capacity_;
+    Overflow overflow_;
+    std::optional< std::pmr::monotonic_buffer_resource > resource_;
+  };
+
+  inline ScratchArena::ScratchArena(std::size_t capacity):
+    buffer_(new std::byte[capacity]),
+    capacity_(capacity),
+    overflow_(),
+    resource_()
+  {
+    accounting::allocated(capacity_);
+    resource_.emplace(buffer_.get(), capacity_, std::addressof(overflow_));
+  }
+
+  inline ScratchArena::~ScratchArena()
+  {
+    resource_.reset();
+    accounting::freed(capacity_);
+  }
+
+  inline std::pmr::memory_resource* ScratchArena::resource() noexcept
+  {
+    return std::addressof(*resource_);
+  }
+
+  template< typename T >
+  std::pmr::polymorphic_allocator< T > ScratchArena::allocator() noexcept
+  {
+    return std::pmr::polymorphic_allocator< T >(resource());
+  }
+
+  inline void ScratchArena::reset()
+  {
+    resource_->release();
+    if (overflow_.requested_ == 0)
+    {
+      return;
+    }
+    // Grow so that a command of the same size fits in the buffer next time.
+    std::size_t capacity = capacity_;
+    while (capacity < capacity_ + overflow_.requested_)
+    {
+      capacity *= 2;
+    }
+    std::unique_ptr< std::byte[] > buffer(new std::byte[capacity]);
+    resource_.reset();
+    overflow_.requested_ = 0;
+    buffer_ = std::move(buffer);
+    accounting::freed(capacity_);
+    accounting::allocated(capacity);
+    capacity_ = capacity;
+    resource_.emplace(buffer_.get(), capacity_, std::addressof(overflow_));
+  }
+
+  inline std::size_t ScratchArena::getCapacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  inline void* ScratchArena::Overflow::do_allocate(std::size_t bytes, std::size_t alignment)
+  {
+    requested_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  inline void ScratchArena::Overflow::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment)
+  {
+    std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+  }
+
+  inline bool ScratchArena::Overflow::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    return this == std::addressof(other);
+  }
+}
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef S3_SPSCRING_H
+#define S3_SPSCRING_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace bendryshev
+{
+  template< typename T >
+  class SpscRing
+  {
+  public:
+    explicit SpscRing(std::size_t capacity);
+    SpscRing(const SpscRing< T >&) = delete;
+    SpscRing< T >& operator=(const SpscRing< T >&) = delete;
+
+    bool tryPush(T&&);
+    bool tryPop(T&);
+    void push(T&&);
+    void pop(T&);
+    std::size_t getCapacity() const noexcept;
+  private:
+    static constexpr std::size_t cache_line = 64;
+    static constexpr unsigned spin_limit = 256;
+
+    class Parking
+    {
+    public:
+      template< typename Ready >
+      void wait(Ready);
+      void wake();
+    private:
+      std::mutex mutex_;
+      std::condition_variable changed_;
+      std::atomic< bool > waiting_ { false };
+    };
+
+    std::unique_ptr< T[] > slots_;
+    std::size_t mask_;
+    alignas(cache_line) std::atomic< std::size_t > head_;
+    std::size_t cached_tail_;
+    alignas(cache_line) std::atomic< std::size_t > tail_;
+    std::size_t cached_head_;
+    alignas(cache_line) Parking not_empty_;
+    Parking not_full_;
+
+    static std::size_t roundUp(std::size_t) noexcept;
+  };
+
+  template< typename T >
+  SpscRing< T >::SpscRing(std::size_t capacity):
+    slots_(new T[roundUp(capacity)]),
+    mask_(roundUp(capacity) - 1),
+    head_(0),
+    cached_tail_(0),
+    tail_(0),
+    cached_head_(0)
+  {}
+
+  template< typename T >
+  bool SpscRing< T >::tryPush(T&& value)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_)
+    {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ > mask_)
+      {
+        return false;
+      }
+    }
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    not_empty_.wake();
+    return true;
+  }
+
+  template< typename T >
+  bool SpscRing< T >::tryPop(T& value)
+  {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_)
+    {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_)
+      {
+        return false;
+      }
+    }
+    value = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    not_full_.wake();
+    return true;
+  }
+
+  template< typename T >
+  void SpscRing< T >::push(T&& value)
+  {
+    while (!tryPush(std::move(value)))
+    {
+      not_full_.wait([this]()
+      {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) <= mask_;
+      });
+    }
+  }
+
+  template< typename T >
+  void SpscRing< T >::pop(T& value)
+  {
+    while (!tryPop(value))
+    {
+      not_empty_.wait([this]()
+      {
+        return tail_.load(std::memory_order_acquire) != head_.load(std::memory_order_relaxed);
+      });
+    }
+  }
+
+  template< typename T >
+  std::size_t SpscRing< T >::getCapacity() const noexcept
+  {
+    return mask_ + 1;
+  }
+
+  template< typename T >
+  std::size_t SpscRing< T >::roundUp(std::size_t capacity) noexcept
+  {
+    std::size_t rounded = 2;
+    while (rounded < capacity)
+    {
+      rounded *= 2;
+    }
+    return rounded;
+  }
+
+  template< typename T >
+  template< typename Ready >
+  void SpscRing< T >::Parking::wait(Ready ready)
+  {
+    for (unsigned i = 0; i < spin_limit; ++i)
+    {
+      if (ready())
+      {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock< std::mutex > lock(mutex_);
+    waiting_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!ready())
+    {
+      changed_.wait(lock);
+    }
+    waiting_.store(false, std::memory_order_relaxed);
+  }
+
+  template< typename T >
+  void SpscRing< T >::Parking::wake()
+  {
+    // Pairs with the fence in wait(): either the sleeper sees the new index or we see it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_relaxed))
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      changed_.notify_one();
+    }
+  }
+}
+
+#endif
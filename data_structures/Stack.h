@@ -1,53 +1,69 @@
-#ifndef S1_STACK_H
-#define S1_STACK_H
-
-#include "data_structures/BidirectionalList.h"
-
-namespace bendryshev
-{
-  template< typename T >
-  class Stack
-  {
-  public:
-
-    void push(const T& rhs);
-    const T& getTop() const;
-    void drop();
-    bool isEmpty() const;
-
-  private:
-    BidirectionalList< T > items_;
-  };
-
-  template< typename T >
-  void bendryshev::Stack< T >::push(const T& rhs)
-  {
-    items_.pushFront(rhs);
-  }
-  template< typename T >
-  const T& bendryshev::Stack< T >::getTop() const
-  {
-    if (items_.isEmpty())
-    {
-      throw std::logic_error("Stack is empty");
-    }
-    return items_.getFrontData();
-  }
-
-  template< typename T >
-  void bendryshev::Stack< T >::drop()
-  {
-    if (isEmpty())
-    {
-      throw std::logic_error("Stack is empty");
-    }
-    items_.popFront();
-  }
-
-  template< typename T >
-  bool bendryshev::Stack< T >::isEmpty() const
-  {
-    return items_.isEmpty();
-  }
-}
-#endif
+#ifndef S1_STACK_H
+#define S1_STACK_H
+
+#include <stdexcept>
+#include "data_structures/RingBuffer.h"
+
+namespace bendryshev
+{
+  template< typename T >
+  class Stack
+  {
+  public:
+
+    void push(const T& rhs);
+    void push(T&& rhs);
+    const T& getTop() const;
+    void drop();
+    bool isEmpty() const;
+    std::size_t getSize() const;
+
+  private:
+    RingBuffer< T > items_;
+  };
+
+  template< typename T >
+  void bendryshev::Stack< T >::push(const T& rhs)
+  {
+    items_.pushBack(rhs);
+  }
+
+  template< typename T >
+  void bendryshev::Stack< T >::push(T&& rhs)
+  {
+    items_.pushBack(std::move(rhs));
+  }
+
+  template< typename T >
+  const T& bendryshev::Stack< T >::getTop() const
+  {
+    if (items_.isEmpty())
+    {
+      throw std::logic_error("Stack is empty");
+    }
+    return items_.back();
+  }
+
+  template< typename T >
+  void bendryshev::Stack< T >::drop()
+  {
+    if (isEmpty())
+    {
+      throw std::logic_error("Stack is empty");
+    }
+    items_.popBack();
+  }
+
+  template< typename T >
+  bool bendryshev::Stack< T >::isEmpty() const
+  {
+    return items_.isEmpty();
+  }
+
+  template< typename T >
+  std::size_t bendryshev::Stack< T >::getSize() const
+  {
+    return items_.getSize();
+  }
+}
+#endif
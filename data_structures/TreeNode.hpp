@@ -1,19 +1,35 @@
-  #ifndef S4_TREENODE_HPP
-  #define S4_TREENODE_HPP
-
-  namespace bendryshev
-  {
-    namespace detail
-    {
-      template< typename T, typename Compare >
-      struct TreeNode
-      {
-      public:
-        T data_;
-        TreeNode< T, Compare >* left_;
-        TreeNode< T, Compare >* right_;
-        int balanceFactor_;
-      };
-    }
-  }
-  #endif
+  #ifndef S4_TREENODE_HPP
+  #define S4_TREENODE_HPP
+
+  #include "data_structures/ContainerAccounting.h"
+
+  namespace bendryshev
+  {
+    namespace detail
+    {
+      template< typename T, typename Compare >
+      struct TreeNode
+      {
+      public:
+        T data_;
+        TreeNode< T, Compare >* left_;
+        TreeNode< T, Compare >* right_;
+        int balanceFactor_;
+  #if S3_CONTAINER_ACCOUNTING
+        static void* operator new(std::size_t size)
+        {
+          void* memory = ::operator new(size);
+          accounting::allocated(size);
+          return memory;
+        }
+
+        static void operator delete(void* memory, std::size_t size) noexcept
+        {
+          accounting::freed(size);
+          ::operator delete(memory);
+        }
+  #endif
+      };
+    }
+  }
+  #endif
@@ -0,0 +1,285 @@
+#include "io/Journal.h"
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+  constexpr std::size_t length_size = sizeof(std::uint32_t);
+  constexpr std::size_t checksum_size = sizeof(std::uint32_t);
+  constexpr std::uint32_t fnv_offset_basis = 2166136261U;
+  constexpr std::uint32_t fnv_prime = 16777619U;
+
+  std::uint32_t checksum(const char* data, std::size_t length) noexcept
+  {
+    std::uint32_t result = fnv_offset_basis;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      result = (result ^ static_cast< unsigned char >(data[i])) * fnv_prime;
+    }
+    return result;
+  }
+
+  std::uint32_t loadLittleEndian(const char* data) noexcept
+  {
+    std::uint32_t value = 0;
+    for (std::size_t i = sizeof(std::uint32_t); i != 0; --i)
+    {
+      value = (value << 8) | static_cast< unsigned char >(data[i - 1]);
+    }
+    return value;
+  }
+
+  int openJournal(const std::string& path, std::uint64_t valid_size)
+  {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    if (::ftruncate(fd, static_cast< off_t >(valid_size)) != 0)
+    {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    return fd;
+  }
+
+  class RecordReader
+  {
+  public:
+    RecordReader(const char* first, const char* last):
+      current_(first),
+      last_(last)
+    {}
+
+    std::uint32_t readInteger()
+    {
+      return loadLittleEndian(take(sizeof(std::uint32_t)));
+    }
+
+    std::string readName()
+    {
+      std::size_t length = readInteger();
+      const char* data = take(length);
+      return std::string(data, length);
+    }
+
+    const char* take(std::size_t length)
+    {
+      if (static_cast< std::size_t >(last_ - current_) < length)
+      {
+        throw std::invalid_argument("truncated journal record");
+      }
+      const char* data = current_;
+      current_ += length;
+      return data;
+    }
+
+    bool atEnd() const noexcept
+    {
+      return current_ == last_;
+    }
+  private:
+    const char* current_;
+    const char* last_;
+  };
+}
+
+bendryshev::JournalWriter::JournalWriter(const std::string& path, std::uint64_t valid_size):
+  fd_(openJournal(path, valid_size)),
+  path_(path),
+  out_(fd_),
+  record_(),
+  pending_(false)
+{}
+
+bendryshev::JournalWriter::~JournalWriter()
+{
+  try
+  {
+    commit();
+  }
+  catch (const std::system_error&)
+  {}
+  ::close(fd_);
+}
+
+void bendryshev::JournalWriter::replaceValue(const std::string& name, std::int32_t from, std::int32_t to)
+{
+  beginRecord(JournalOp::replace_value);
+  putName(name);
+  putInteger(static_cast< std::uint32_t >(from), sizeof(std::uint32_t));
+  putInteger(static_cast< std::uint32_t >(to), sizeof(std::uint32_t));
+  endRecord();
+}
+
+void bendryshev::JournalWriter::replaceList(const std::string& name, std::int32_t from, const std::string& list)
+{
+  beginRecord(JournalOp::replace_list);
+  putName(name);
+  putInteger(static_cast< std::uint32_t >(from), sizeof(std::uint32_t));
+  putName(list);
+  endRecord();
+}
+
+void bendryshev::JournalWriter::removeValue(const std::string& name, std::int32_t value)
+{
+  beginRecord(JournalOp::remove_value);
+  putName(name);
+  putInteger(static_cast< std::uint32_t >(value), sizeof(std::uint32_t));
+  endRecord();
+}
+
+void bendryshev::JournalWriter::removeList(const std::string& name, const std::string& list)
+{
+  beginRecord(JournalOp::remove_list);
+  putName(name);
+  putName(list);
+  endRecord();
+}
+
+void bendryshev::JournalWriter::loadSnapshot(const std::string& path)
+{
+  beginRecord(JournalOp::load_snapshot);
+  putName(path);
+  endRecord();
+}
+
+void bendryshev::JournalWriter::mapSnapshot(const std::string& path)
+{
+  beginRecord(JournalOp::map_snapshot);
+  putName(path);
+  endRecord();
+}
+
+void bendryshev::JournalWriter::commit()
+{
+  if (!pending_)
+  {
+    return;
+  }
+  out_.flush();
+  pending_ = false;
+  if (!out_.good() || ::fdatasync(fd_) != 0)
+  {
+    throw std::system_error(errno, std::generic_category(), path_);
+  }
+}
+
+void bendryshev::JournalWriter::beginRecord(JournalOp op)
+{
+  record_.assign(length_size, '\0');
+  record_.push_back(static_cast< char >(op));
+}
+
+void bendryshev::JournalWriter::putInteger(std::uint64_t value, std::size_t length)
+{
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    record_.push_back(static_cast< char >(value >> (8 * i)));
+  }
+}
+
+void bendryshev::JournalWriter::putName(const std::string& name)
+{
+  putInteger(name.size(), sizeof(std::uint32_t));
+  record_.append(name);
+}
+
+void bendryshev::JournalWriter::patchCount(std::size_t offset, std::uint32_t count)
+{
+  for (std::size_t i = 0; i < sizeof(std::uint32_t); ++i)
+  {
+    record_[offset + i] = static_cast< char >(count >> (8 * i));
+  }
+}
+
+void bendryshev::JournalWriter::endRecord()
+{
+  std::size_t payload_size = record_.size() - length_size;
+  for (std::size_t i = 0; i < length_size; ++i)
+  {
+    record_[i] = static_cast< char >(payload_size >> (8 * i));
+  }
+  putInteger(checksum(record_.data() + length_size, payload_size), checksum_size);
+  out_.write(record_.data(), record_.size());
+  pending_ = true;
+}
+
+bendryshev::JournalReader::JournalReader(const std::string& path):
+  file_(path),
+  current_(file_.begin())
+{}
+
+bool bendryshev::JournalReader::next(JournalRecord& record)
+{
+  std::size_t left = static_cast< std::size_t >(file_.end() - current_);
+  if (left < length_size + checksum_size)
+  {
+    return false;
+  }
+  std::size_t payload_size = loadLittleEndian(current_);
+  if (payload_size > left - length_size - checksum_size)
+  {
+    return false;
+  }
+  const char* payload = current_ + length_size;
+  if (checksum(payload, payload_size) != loadLittleEndian(payload + payload_size))
+  {
+    return false;
+  }
+  RecordReader reader(payload, payload + payload_size);
+  record.op_ = static_cast< JournalOp >(*reader.take(1));
+  record.name_ = reader.readName();
+  record.lists_.clear();
+  record.values_.clear();
+  switch (record.op_)
+  {
+  case JournalOp::replace_value:
+    record.first_ = static_cast< std::int32_t >(reader.readInteger());
+    record.second_ = static_cast< std::int32_t >(reader.readInteger());
+    break;
+  case JournalOp::replace_list:
+    record.first_ = static_cast< std::int32_t >(reader.readInteger());
+    record.lists_.pushBack(reader.readName());
+    break;
+  case JournalOp::remove_value:
+    record.first_ = static_cast< std::int32_t >(reader.readInteger());
+    break;
+  case JournalOp::remove_list:
+    record.lists_.pushBack(reader.readName());
+    break;
+  case JournalOp::concat:
+    for (std::uint32_t count = reader.readInteger(); count != 0; --count)
+    {
+      record.lists_.pushBack(reader.readName());
+    }
+    break;
+  case JournalOp::assign_list:
+    for (std::uint32_t count = reader.readInteger(); count != 0; --count)
+    {
+      record.values_.pushBack(static_cast< std::int32_t >(reader.readInteger()));
+    }
+    break;
+  case JournalOp::load_snapshot:
+  case JournalOp::map_snapshot:
+    break;
+  default:
+    throw std::invalid_argument("unknown journal record");
+  }
+  if (!reader.atEnd())
+  {
+    throw std::invalid_argument("trailing data in journal record");
+  }
+  current_ = payload + payload_size + checksum_size;
+  return true;
+}
+
+std::uint64_t bendryshev::JournalReader::validSize() const noexcept
+{
+  return static_cast< std::uint64_t >(current_ - file_.begin());
+}
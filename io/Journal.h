@@ -0,0 +1,115 @@
+#ifndef S3_JOURNAL_H
+#define S3_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "data_structures/BidirectionalList.h"
+#include "io/MappedFile.h"
+#include "io/OutputSink.h"
+
+namespace bendryshev
+{
+  enum class JournalOp: std::uint8_t
+  {
+    replace_value = 1,
+    replace_list = 2,
+    remove_value = 3,
+    remove_list = 4,
+    concat = 5,
+    assign_list = 6,
+    load_snapshot = 7,
+    map_snapshot = 8
+  };
+
+  struct JournalRecord
+  {
+    JournalOp op_;
+    std::string name_;
+    std::int32_t first_;
+    std::int32_t second_;
+    BidirectionalList< std::string > lists_;
+    BidirectionalList< std::int32_t > values_;
+  };
+
+  class JournalWriter
+  {
+  public:
+    JournalWriter(const std::string&, std::uint64_t valid_size);
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+    ~JournalWriter();
+
+    void replaceValue(const std::string&, std::int32_t from, std::int32_t to);
+    void replaceList(const std::string&, std::int32_t from, const std::string&);
+    void removeValue(const std::string&, std::int32_t);
+    void removeList(const std::string&, const std::string&);
+    template< typename InputIt >
+    void concat(const std::string&, InputIt, InputIt);
+    template< typename InputIt >
+    void assignList(const std::string&, InputIt, InputIt);
+    void loadSnapshot(const std::string&);
+    void mapSnapshot(const std::string&);
+    void commit();
+  private:
+    int fd_;
+    std::string path_;
+    OutputSink out_;
+    std::string record_;
+    bool pending_;
+
+    void beginRecord(JournalOp);
+    void putInteger(std::uint64_t, std::size_t);
+    void putName(const std::string&);
+    void patchCount(std::size_t, std::uint32_t);
+    void endRecord();
+  };
+
+  class JournalReader
+  {
+  public:
+    explicit JournalReader(const std::string&);
+
+    bool next(JournalRecord&);
+    std::uint64_t validSize() const noexcept;
+  private:
+    MappedFile file_;
+    const char* current_;
+  };
+
+  template< typename InputIt >
+  void JournalWriter::concat(const std::string& name, InputIt first, InputIt last)
+  {
+    beginRecord(JournalOp::concat);
+    putName(name);
+    std::size_t count_offset = record_.size();
+    putInteger(0, sizeof(std::uint32_t));
+    std::uint32_t count = 0;
+    for (auto it = first; it != last; ++it)
+    {
+      putName(*it);
+      ++count;
+    }
+    patchCount(count_offset, count);
+    endRecord();
+  }
+
+  template< typename InputIt >
+  void JournalWriter::assignList(const std::string& name, InputIt first, InputIt last)
+  {
+    beginRecord(JournalOp::assign_list);
+    putName(name);
+    std::size_t count_offset = record_.size();
+    putInteger(0, sizeof(std::uint32_t));
+    std::uint32_t count = 0;
+    for (auto it = first; it != last; ++it)
+    {
+      putInteger(static_cast< std::uint32_t >(*it), sizeof(std::uint32_t));
+      ++count;
+    }
+    patchCount(count_offset, count);
+    endRecord();
+  }
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "io/ListFileLoader.h"
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <thread>
+#include "io/ListParser.h"
+#include "io/MappedFile.h"
+
+namespace
+{
+  using loaded_lists = bendryshev::BidirectionalList< bendryshev::loaded_list >;
+
+  constexpr std::size_t min_chunk_size = 1 << 20;
+
+  struct Chunk
+  {
+    const char* first_;
+    const char* last_;
+    loaded_lists lists_;
+    std::exception_ptr error_;
+  };
+
+  void parseChunk(Chunk& chunk)
+  {
+    try
+    {
+      chunk.lists_ = bendryshev::parseListFile(chunk.first_, chunk.last_);
+    }
+    catch (...)
+    {
+      chunk.error_ = std::current_exception();
+    }
+  }
+
+  const char* alignToLineStart(const char* pos, const char* first, const char* last)
+  {
+    if (pos == first || pos == last || pos[-1] == '\n')
+    {
+      return pos;
+    }
+    const char* line_end = bendryshev::findLineEnd(pos, last);
+    return (line_end == last) ? last : line_end + 1;
+  }
+
+  void joinAll(bendryshev::BidirectionalList< std::thread >& workers)
+  {
+    for (auto&& worker: workers)
+    {
+      worker.join();
+    }
+  }
+}
+
+bendryshev::BidirectionalList< bendryshev::loaded_list > bendryshev::parseListFile(const char* first, const char* last)
+{
+  loaded_lists result;
+  std::string name;
+  while (first != last)
+  {
+    const char* line_end = findLineEnd(first, last);
+    BidirectionalList< int > values;
+    if (parseListLine(first, line_end, name, values))
+    {
+      result.pushBack(loaded_list(std::move(name), std::move(values)));
+    }
+    first = (line_end == last) ? last : line_end + 1;
+  }
+  return result;
+}
+
+bendryshev::BidirectionalList< bendryshev::loaded_list > bendryshev::parseListFile(const char* first, const char* last, unsigned threads)
+{
+  if (threads == 0)
+  {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  std::size_t size = static_cast< std::size_t >(last - first);
+  std::size_t chunks = std::min< std::size_t >(threads, size / min_chunk_size);
+  if (chunks <= 1)
+  {
+    return parseListFile(first, last);
+  }
+  BidirectionalList< Chunk > parts;
+  const char* chunk_first = first;
+  for (std::size_t i = 1; i <= chunks; ++i)
+  {
+    const char* chunk_last = std::max(chunk_first, alignToLineStart(first + size / chunks * i, first, last));
+    parts.pushBack(Chunk { chunk_first, chunk_last, loaded_lists(), nullptr });
+    chunk_first = chunk_last;
+  }
+  BidirectionalList< std::thread > workers;
+  try
+  {
+    auto it = parts.begin();
+    Chunk& own_chunk = *(it++);
+    while (it != parts.end())
+    {
+      workers.pushBack(std::thread(parseChunk, std::ref(*(it++))));
+    }
+    parseChunk(own_chunk);
+  }
+  catch (...)
+  {
+    joinAll(workers);
+    throw;
+  }
+  joinAll(workers);
+  loaded_lists result;
+  for (auto&& chunk: parts)
+  {
+    if (chunk.error_)
+    {
+      std::rethrow_exception(chunk.error_);
+    }
+    result.splice(result.end(), chunk.lists_);
+  }
+  return result;
+}
+
+bendryshev::BidirectionalList< bendryshev::loaded_list > bendryshev::loadListFile(const std::string& path, unsigned threads)
+{
+  MappedFile file(path);
+  return parseListFile(file.begin(), file.end(), threads);
+}
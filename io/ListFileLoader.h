@@ -0,0 +1,17 @@
+#ifndef S3_LISTFILELOADER_H
+#define S3_LISTFILELOADER_H
+
+#include <string>
+#include <utility>
+#include "data_structures/BidirectionalList.h"
+
+namespace bendryshev
+{
+  using loaded_list = std::pair< std::string, BidirectionalList< int > >;
+
+  BidirectionalList< loaded_list > parseListFile(const char*, const char*);
+  BidirectionalList< loaded_list > parseListFile(const char*, const char*, unsigned threads);
+  BidirectionalList< loaded_list > loadListFile(const std::string&, unsigned threads = 0);
+}
+
+#endif
@@ -0,0 +1,176 @@
+#include "io/ListParser.h"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+  bool isDigit(char c) noexcept
+  {
+    return static_cast< unsigned char >(c - '0') < 10;
+  }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  constexpr bool swar_digits = true;
+#else
+  constexpr bool swar_digits = false;
+#endif
+
+  std::uint32_t parseEightDigits(const char* digits) noexcept
+  {
+    std::uint64_t block = 0;
+    std::memcpy(std::addressof(block), digits, sizeof(block));
+    block = ((block & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    block = ((block & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return static_cast< std::uint32_t >(((block & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+  }
+
+  std::uint32_t parseShortDigits(const char* first, std::size_t length) noexcept
+  {
+    char block[8] = { '0', '0', '0', '0', '0', '0', '0', '0' };
+    std::memcpy(block + sizeof(block) - length, first, length);
+    return parseEightDigits(block);
+  }
+}
+
+bool bendryshev::isSeparator(char c) noexcept
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* bendryshev::skipSeparators(const char* first, const char* last) noexcept
+{
+  while (first != last && isSeparator(*first))
+  {
+    ++first;
+  }
+  return first;
+}
+
+const char* bendryshev::findSeparator(const char* first, const char* last) noexcept
+{
+  while (first != last && !isSeparator(*first))
+  {
+    ++first;
+  }
+  return first;
+}
+
+const char* bendryshev::findDigitsEnd(const char* first, const char* last) noexcept
+{
+#if defined(__AVX2__)
+  const __m256i below_zero_256 = _mm256_set1_epi8('0' - 1);
+  const __m256i above_nine_256 = _mm256_set1_epi8('9' + 1);
+  while (last - first >= 32)
+  {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(first));
+    __m256i digits = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, below_zero_256), _mm256_cmpgt_epi8(above_nine_256, chunk));
+    unsigned mask = ~static_cast< unsigned >(_mm256_movemask_epi8(digits));
+    if (mask != 0)
+    {
+      return first + __builtin_ctz(mask);
+    }
+    first += 32;
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i below_zero = _mm_set1_epi8('0' - 1);
+  const __m128i above_nine = _mm_set1_epi8('9' + 1);
+  while (last - first >= 16)
+  {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast< const __m128i* >(first));
+    __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(chunk, below_zero), _mm_cmplt_epi8(chunk, above_nine));
+    unsigned mask = ~static_cast< unsigned >(_mm_movemask_epi8(digits)) & 0xFFFFu;
+    if (mask != 0)
+    {
+      return first + __builtin_ctz(mask);
+    }
+    first += 16;
+  }
+#endif
+  while (first != last && isDigit(*first))
+  {
+    ++first;
+  }
+  return first;
+}
+
+const char* bendryshev::findLineEnd(const char* first, const char* last) noexcept
+{
+  const void* line_end = std::memchr(first, '\n', static_cast< std::size_t >(last - first));
+  return line_end ? static_cast< const char* >(line_end) : last;
+}
+
+bool bendryshev::tryParseNumber(const char* first, const char* last, int& value) noexcept
+{
+  const char* number = first;
+  bool negative = false;
+  if (first != last && (*first == '-' || *first == '+'))
+  {
+    negative = *first == '-';
+    ++first;
+  }
+  const char* digits_end = findDigitsEnd(first, last);
+  std::size_t length = static_cast< std::size_t >(digits_end - first);
+  if (length == 0 || digits_end != last)
+  {
+    return false;
+  }
+  if (swar_digits && length <= 8)
+  {
+    int result = static_cast< int >(parseShortDigits(first, length));
+    value = negative ? -result : result;
+    return true;
+  }
+  std::from_chars_result result = std::from_chars(negative ? number : first, last, value);
+  return result.ec == std::errc() && result.ptr == last;
+}
+
+bool bendryshev::tryParseNumber(const std::string& str, int& value) noexcept
+{
+  return tryParseNumber(str.data(), str.data() + str.size(), value);
+}
+
+int bendryshev::parseNumber(const std::string& str)
+{
+  int value = 0;
+  if (!tryParseNumber(str, value))
+  {
+    throw std::invalid_argument("not a number");
+  }
+  return value;
+}
+
+void bendryshev::parseNumbers(const char* first, const char* last, BidirectionalList< int >& values)
+{
+  first = skipSeparators(first, last);
+  while (first != last)
+  {
+    const char* token_end = findSeparator(first, last);
+    int value = 0;
+    if (!tryParseNumber(first, token_end, value))
+    {
+      throw std::invalid_argument("not a number");
+    }
+    values.pushBack(value);
+    first = skipSeparators(token_end, last);
+  }
+}
+
+bool bendryshev::parseListLine(const char* first, const char* last, std::string& name, BidirectionalList< int >& values)
+{
+  first = skipSeparators(first, last);
+  if (first == last)
+  {
+    return false;
+  }
+  const char* name_end = findSeparator(first, last);
+  name.assign(first, name_end);
+  parseNumbers(name_end, last, values);
+  return true;
+}
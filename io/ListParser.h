@@ -0,0 +1,22 @@
+#ifndef S3_LISTPARSER_H
+#define S3_LISTPARSER_H
+
+#include <string>
+#include "data_structures/BidirectionalList.h"
+
+namespace bendryshev
+{
+  bool isSeparator(char) noexcept;
+  const char* skipSeparators(const char*, const char*) noexcept;
+  const char* findSeparator(const char*, const char*) noexcept;
+  const char* findDigitsEnd(const char*, const char*) noexcept;
+  const char* findLineEnd(const char*, const char*) noexcept;
+
+  bool tryParseNumber(const char*, const char*, int&) noexcept;
+  bool tryParseNumber(const std::string&, int&) noexcept;
+  int parseNumber(const std::string&);
+  void parseNumbers(const char*, const char*, BidirectionalList< int >&);
+  bool parseListLine(const char*, const char*, std::string&, BidirectionalList< int >&);
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "io/MappedFile.h"
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bendryshev::MappedFile::MappedFile(const std::string& path):
+  data_(nullptr),
+  size_(0)
+{
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  struct stat info {};
+  if (::fstat(fd, std::addressof(info)) != 0)
+  {
+    int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  size_ = static_cast< std::size_t >(info.st_size);
+  if (size_ != 0)
+  {
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data_ == MAP_FAILED)
+    {
+      int error = errno;
+      ::close(fd);
+      data_ = nullptr;
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+  ::close(fd);
+}
+
+bendryshev::MappedFile::MappedFile(MappedFile&& rhs) noexcept:
+  data_(rhs.data_),
+  size_(rhs.size_)
+{
+  rhs.data_ = nullptr;
+  rhs.size_ = 0;
+}
+
+bendryshev::MappedFile::~MappedFile()
+{
+  if (data_)
+  {
+    ::munmap(data_, size_);
+  }
+}
+
+bendryshev::MappedFile& bendryshev::MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+  if (this != std::addressof(rhs))
+  {
+    MappedFile temp(std::move(rhs));
+    swap(temp);
+  }
+  return *this;
+}
+
+void bendryshev::MappedFile::swap(MappedFile& rhs) noexcept
+{
+  std::swap(data_, rhs.data_);
+  std::swap(size_, rhs.size_);
+}
+
+const char* bendryshev::MappedFile::begin() const noexcept
+{
+  return static_cast< const char* >(data_);
+}
+
+const char* bendryshev::MappedFile::end() const noexcept
+{
+  return begin() + size_;
+}
+
+std::size_t bendryshev::MappedFile::size() const noexcept
+{
+  return size_;
+}
@@ -0,0 +1,29 @@
+#ifndef S3_MAPPEDFILE_H
+#define S3_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace bendryshev
+{
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string&);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept;
+    ~MappedFile();
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    void swap(MappedFile&) noexcept;
+    const char* begin() const noexcept;
+    const char* end() const noexcept;
+    std::size_t size() const noexcept;
+  private:
+    void* data_;
+    std::size_t size_;
+  };
+}
+
+#endif
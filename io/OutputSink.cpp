@@ -0,0 +1,88 @@
+#include "io/OutputSink.h"
+#include <algorithm>
+#include <cerrno>
+#include <ostream>
+#include <unistd.h>
+
+bendryshev::OutputSink::OutputSink(int fd, std::size_t capacity):
+  fd_(fd),
+  stream_(nullptr),
+  string_(nullptr),
+  buffer_(new char[std::max(capacity, max_number_length)]),
+  capacity_(std::max(capacity, max_number_length)),
+  size_(0),
+  good_(fd >= 0)
+{}
+
+bendryshev::OutputSink::OutputSink(std::ostream& out, std::size_t capacity):
+  fd_(-1),
+  stream_(std::addressof(out)),
+  string_(nullptr),
+  buffer_(new char[std::max(capacity, max_number_length)]),
+  capacity_(std::max(capacity, max_number_length)),
+  size_(0),
+  good_(true)
+{}
+
+bendryshev::OutputSink::OutputSink(std::string& out, std::size_t capacity):
+  fd_(-1),
+  stream_(nullptr),
+  string_(std::addressof(out)),
+  buffer_(new char[std::max(capacity, max_number_length)]),
+  capacity_(std::max(capacity, max_number_length)),
+  size_(0),
+  good_(true)
+{}
+
+bendryshev::OutputSink::~OutputSink()
+{
+  flush();
+}
+
+void bendryshev::OutputSink::flush()
+{
+  if (size_ != 0)
+  {
+    writeToBackend(buffer_.get(), size_);
+    size_ = 0;
+  }
+}
+
+bool bendryshev::OutputSink::good() const noexcept
+{
+  return good_;
+}
+
+void bendryshev::OutputSink::writeToBackend(const char* data, std::size_t length)
+{
+  if (!good_)
+  {
+    return;
+  }
+  if (stream_)
+  {
+    stream_->write(data, static_cast< std::streamsize >(length));
+    good_ = stream_->good();
+    return;
+  }
+  if (string_)
+  {
+    string_->append(data, length);
+    return;
+  }
+  while (length != 0)
+  {
+    ssize_t written = ::write(fd_, data, length);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      good_ = false;
+      return;
+    }
+    data += written;
+    length -= static_cast< std::size_t >(written);
+  }
+}
@@ -0,0 +1,117 @@
+#ifndef S3_OUTPUTSINK_H
+#define S3_OUTPUTSINK_H
+
+#include <cstddef>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <iosfwd>
+
+namespace bendryshev
+{
+  class OutputSink
+  {
+  public:
+    static constexpr std::size_t default_capacity = 1 << 16;
+
+    explicit OutputSink(int fd, std::size_t capacity = default_capacity);
+    explicit OutputSink(std::ostream&, std::size_t capacity = default_capacity);
+    explicit OutputSink(std::string&, std::size_t capacity = default_capacity);
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+    ~OutputSink();
+
+    OutputSink& operator<<(const std::string&);
+    OutputSink& operator<<(const char*);
+    OutputSink& operator<<(char);
+    OutputSink& operator<<(int);
+    OutputSink& operator<<(long);
+    OutputSink& operator<<(unsigned long);
+
+    void write(const char*, std::size_t);
+    void flush();
+    bool good() const noexcept;
+  private:
+    static constexpr std::size_t max_number_length = 24;
+
+    int fd_;
+    std::ostream* stream_;
+    std::string* string_;
+    std::unique_ptr< char[] > buffer_;
+    std::size_t capacity_;
+    std::size_t size_;
+    bool good_;
+
+    void writeToBackend(const char*, std::size_t);
+    template< typename Number >
+    OutputSink& writeNumber(Number);
+  };
+
+  template< typename Number >
+  OutputSink& OutputSink::writeNumber(Number value)
+  {
+    if (capacity_ - size_ < max_number_length)
+    {
+      flush();
+    }
+    char* first = buffer_.get() + size_;
+    std::to_chars_result result = std::to_chars(first, first + max_number_length, value);
+    size_ += result.ptr - first;
+    return *this;
+  }
+
+  inline OutputSink& OutputSink::operator<<(int value)
+  {
+    return writeNumber(value);
+  }
+
+  inline OutputSink& OutputSink::operator<<(long value)
+  {
+    return writeNumber(value);
+  }
+
+  inline OutputSink& OutputSink::operator<<(unsigned long value)
+  {
+    return writeNumber(value);
+  }
+
+  inline OutputSink& OutputSink::operator<<(char c)
+  {
+    if (size_ == capacity_)
+    {
+      flush();
+    }
+    buffer_[size_++] = c;
+    return *this;
+  }
+
+  inline void OutputSink::write(const char* data, std::size_t length)
+  {
+    if (capacity_ - size_ < length)
+    {
+      flush();
+      if (length >= capacity_)
+      {
+        writeToBackend(data, length);
+        return;
+      }
+    }
+    std::memcpy(buffer_.get() + size_, data, length);
+    size_ += length;
+  }
+
+  inline OutputSink& OutputSink::operator<<(const std::string& str)
+  {
+    write(str.data(), str.size());
+    return *this;
+  }
+
+  inline OutputSink& OutputSink::operator<<(const char* str)
+  {
+    write(str, std::strlen(str));
+    return *this;
+  }
+}
+
+#endif
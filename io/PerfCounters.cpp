@@ -0,0 +1,182 @@
+#include "io/PerfCounters.h"
+#include <memory>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+  constexpr const char* event_names[bendryshev::perf::event_count] =
+  {
+    "cycles",
+    "instructions",
+    "l1d-misses",
+    "llc-misses",
+    "branch-misses"
+  };
+
+#ifdef __linux__
+  struct EventConfig
+  {
+    std::uint32_t type_;
+    std::uint64_t config_;
+  };
+
+  constexpr EventConfig event_configs[bendryshev::perf::event_count] =
+  {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    {
+      PERF_TYPE_HW_CACHE,
+      PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+  };
+
+  int openEvent(const EventConfig& event, int group) noexcept
+  {
+    perf_event_attr attr {};
+    attr.size = sizeof(attr);
+    attr.type = event.type_;
+    attr.config = event.config_;
+    attr.disabled = group == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast< int >(syscall(SYS_perf_event_open, std::addressof(attr), 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+  }
+#endif
+}
+
+std::atomic< bool > bendryshev::perf::enabled(false);
+
+const char* bendryshev::perf::eventName(std::size_t event) noexcept
+{
+  return event < event_count ? event_names[event] : "";
+}
+
+bendryshev::PerfCounters::PerfCounters() noexcept:
+  leader_(-1),
+  fds_(),
+  slots_(),
+  opened_(0)
+{
+  for (std::size_t i = 0; i < perf::event_count; ++i)
+  {
+    fds_[i] = -1;
+#ifdef __linux__
+    fds_[i] = openEvent(event_configs[i], leader_);
+    if (fds_[i] == -1)
+    {
+      continue;
+    }
+    if (leader_ == -1)
+    {
+      leader_ = fds_[i];
+    }
+    slots_[i] = opened_++;
+#endif
+  }
+#ifdef __linux__
+  if (leader_ != -1)
+  {
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+}
+
+bendryshev::PerfCounters::~PerfCounters()
+{
+  for (std::size_t i = 0; i < perf::event_count; ++i)
+  {
+    if (fds_[i] != -1)
+    {
+      close(fds_[i]);
+    }
+  }
+}
+
+bool bendryshev::PerfCounters::isAvailable() const noexcept
+{
+  return leader_ != -1;
+}
+
+bool bendryshev::PerfCounters::read(PerfSample& sample) noexcept
+{
+  sample.mask_ = 0;
+  if (leader_ == -1)
+  {
+    return false;
+  }
+  std::uint64_t buffer[3 + perf::event_count];
+  std::size_t expected = (3 + opened_) * sizeof(std::uint64_t);
+  if (::read(leader_, buffer, sizeof(buffer)) != static_cast< ssize_t >(expected) || buffer[0] != opened_)
+  {
+    return false;
+  }
+  sample.time_enabled_ = buffer[1];
+  sample.time_running_ = buffer[2];
+  for (std::size_t i = 0; i < perf::event_count; ++i)
+  {
+    if (fds_[i] != -1)
+    {
+      sample.values_[i] = buffer[3 + slots_[i]];
+      sample.mask_ |= 1u << i;
+    }
+  }
+  return true;
+}
+
+bool bendryshev::PerfCounters::elapsed(PerfSample& since) noexcept
+{
+  PerfSample now;
+  if (!since.mask_ || !read(now))
+  {
+    since.mask_ = 0;
+    return false;
+  }
+  std::uint64_t enabled = now.time_enabled_ - since.time_enabled_;
+  std::uint64_t running = now.time_running_ - since.time_running_;
+  if (running == 0)
+  {
+    since.mask_ = 0;
+    return false;
+  }
+  for (std::size_t i = 0; i < perf::event_count; ++i)
+  {
+    if (since.has(i))
+    {
+      std::uint64_t delta = now.values_[i] - since.values_[i];
+      if (running < enabled)
+      {
+        delta = static_cast< std::uint64_t >(static_cast< double >(delta) * enabled / running);
+      }
+      since.values_[i] = delta;
+    }
+  }
+  since.time_enabled_ = enabled;
+  since.time_running_ = running;
+  return true;
+}
+
+bool bendryshev::perf::start() noexcept
+{
+  enabled.store(true, std::memory_order_relaxed);
+  PerfCounters* counters = threadCounters();
+  return counters && counters->isAvailable();
+}
+
+bendryshev::PerfCounters* bendryshev::perf::threadCounters() noexcept
+{
+  if (!isEnabled())
+  {
+    return nullptr;
+  }
+  thread_local PerfCounters counters;
+  return counters.isAvailable() ? std::addressof(counters) : nullptr;
+}
@@ -0,0 +1,70 @@
+#ifndef S3_PERFCOUNTERS_H
+#define S3_PERFCOUNTERS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace bendryshev
+{
+  namespace perf
+  {
+    enum Event
+    {
+      cycles,
+      instructions,
+      l1d_misses,
+      llc_misses,
+      branch_misses,
+      event_count
+    };
+
+    const char* eventName(std::size_t) noexcept;
+  }
+
+  struct PerfSample
+  {
+    std::uint64_t values_[perf::event_count];
+    std::uint64_t time_enabled_;
+    std::uint64_t time_running_;
+    unsigned mask_;
+
+    bool has(std::size_t event) const noexcept
+    {
+      return (mask_ >> event) & 1u;
+    }
+  };
+
+  class PerfCounters
+  {
+  public:
+    PerfCounters() noexcept;
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    ~PerfCounters();
+
+    bool isAvailable() const noexcept;
+    bool read(PerfSample&) noexcept;
+    bool elapsed(PerfSample& since) noexcept;
+  private:
+    int leader_;
+    int fds_[perf::event_count];
+    std::size_t slots_[perf::event_count];
+    std::size_t opened_;
+  };
+
+  namespace perf
+  {
+    extern std::atomic< bool > enabled;
+
+    inline bool isEnabled() noexcept
+    {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    bool start() noexcept;
+    PerfCounters* threadCounters() noexcept;
+  }
+}
+
+#endif
@@ -0,0 +1,298 @@
+#include "io/Snapshot.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+  constexpr char snapshot_magic[4] = { 'B', 'L', 'S', 'T' };
+  constexpr std::uint32_t table_checksum_version = 2;
+  constexpr std::uint32_t snapshot_version = table_checksum_version;
+  constexpr std::uint32_t has_positions_flag = 1;
+  constexpr std::size_t header_size = 20;
+  constexpr std::size_t checksum_size = 8;
+  constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+  constexpr std::uint64_t fnv_prime = 1099511628211ULL;
+
+  std::uint64_t updateChecksum(std::uint64_t checksum, const char* data, std::size_t length) noexcept
+  {
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      checksum = (checksum ^ static_cast< unsigned char >(data[i])) * fnv_prime;
+    }
+    return checksum;
+  }
+
+  std::uint64_t loadLittleEndian(const char* data, std::size_t length) noexcept
+  {
+    std::uint64_t value = 0;
+    for (std::size_t i = length; i != 0; --i)
+    {
+      value = (value << 8) | static_cast< unsigned char >(data[i - 1]);
+    }
+    return value;
+  }
+
+  std::size_t alignedOffset(std::size_t offset) noexcept
+  {
+    return (offset + sizeof(std::int32_t) - 1) & ~(sizeof(std::int32_t) - 1);
+  }
+
+  int openForWriting(const std::string& path)
+  {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    return fd;
+  }
+
+  class TableReader
+  {
+  public:
+    TableReader(const char* first, const char* last):
+      current_(first),
+      last_(last)
+    {}
+
+    std::uint64_t readInteger(std::size_t length)
+    {
+      const char* data = take(length);
+      return loadLittleEndian(data, length);
+    }
+
+    std::string readName()
+    {
+      std::size_t length = readInteger(sizeof(std::uint32_t));
+      const char* data = take(length);
+      return std::string(data, length);
+    }
+
+    const char* take(std::size_t length)
+    {
+      if (static_cast< std::size_t >(last_ - current_) < length)
+      {
+        throw std::invalid_argument("truncated snapshot");
+      }
+      const char* data = current_;
+      current_ += length;
+      return data;
+    }
+
+    const char* takeValues(std::size_t size)
+    {
+      if (size > static_cast< std::size_t >(last_ - current_) / sizeof(std::int32_t))
+      {
+        throw std::invalid_argument("truncated snapshot");
+      }
+      return take(size * sizeof(std::int32_t));
+    }
+
+    const char* current() const noexcept
+    {
+      return current_;
+    }
+  private:
+    const char* current_;
+    const char* last_;
+  };
+}
+
+std::int32_t bendryshev::loadLittleEndian32(const char* data) noexcept
+{
+  return static_cast< std::int32_t >(static_cast< std::uint32_t >(loadLittleEndian(data, sizeof(std::uint32_t))));
+}
+
+void bendryshev::storeLittleEndian32(char* data, std::uint32_t value) noexcept
+{
+  data[0] = static_cast< char >(value);
+  data[1] = static_cast< char >(value >> 8);
+  data[2] = static_cast< char >(value >> 16);
+  data[3] = static_cast< char >(value >> 24);
+}
+
+bendryshev::SnapshotWriter::SnapshotWriter(const std::string& path, std::uint32_t lists, std::uint32_t positions):
+  fd_(openForWriting(path + ".tmp")),
+  path_(path),
+  out_(fd_),
+  offset_(0),
+  checksum_(fnv_offset_basis),
+  table_checksum_(fnv_offset_basis),
+  data_started_(false)
+{
+  writeBytes(snapshot_magic, sizeof(snapshot_magic));
+  writeInteger(snapshot_version, sizeof(std::uint32_t));
+  writeInteger(positions != 0 ? has_positions_flag : 0, sizeof(std::uint32_t));
+  writeInteger(lists, sizeof(std::uint32_t));
+  writeInteger(positions, sizeof(std::uint32_t));
+}
+
+bendryshev::SnapshotWriter::~SnapshotWriter()
+{
+  if (fd_ >= 0)
+  {
+    out_.flush();
+    ::close(fd_);
+    ::unlink((path_ + ".tmp").c_str());
+  }
+}
+
+void bendryshev::SnapshotWriter::writeListHeader(const std::string& name, std::uint64_t size)
+{
+  writeName(name);
+  writeInteger(size, sizeof(std::uint64_t));
+}
+
+void bendryshev::SnapshotWriter::writePositionHeader(const std::string& name, std::int32_t index, std::uint64_t size)
+{
+  writeName(name);
+  writeInteger(static_cast< std::uint32_t >(index), sizeof(std::uint32_t));
+  writeInteger(size, sizeof(std::uint64_t));
+}
+
+void bendryshev::SnapshotWriter::finish()
+{
+  beginData();
+  char trailer[2 * checksum_size];
+  for (std::size_t i = 0; i < checksum_size; ++i)
+  {
+    trailer[i] = static_cast< char >(table_checksum_ >> (8 * i));
+    trailer[checksum_size + i] = static_cast< char >(checksum_ >> (8 * i));
+  }
+  out_.write(trailer, sizeof(trailer));
+  out_.flush();
+  bool written = out_.good() && ::fsync(fd_) == 0;
+  written = (::close(fd_) == 0) && written;
+  fd_ = -1;
+  std::string temp_path = path_ + ".tmp";
+  if (!written || std::rename(temp_path.c_str(), path_.c_str()) != 0)
+  {
+    int error = errno;
+    ::unlink(temp_path.c_str());
+    throw std::system_error(error, std::generic_category(), path_);
+  }
+}
+
+void bendryshev::SnapshotWriter::beginData()
+{
+  if (!data_started_)
+  {
+    const char padding[sizeof(std::int32_t)] = {};
+    writeBytes(padding, alignedOffset(offset_) - offset_);
+    table_checksum_ = checksum_;
+    data_started_ = true;
+  }
+}
+
+void bendryshev::SnapshotWriter::writeBytes(const char* data, std::size_t length)
+{
+  checksum_ = updateChecksum(checksum_, data, length);
+  out_.write(data, length);
+  offset_ += length;
+}
+
+void bendryshev::SnapshotWriter::writeInteger(std::uint64_t value, std::size_t length)
+{
+  char data[sizeof(std::uint64_t)];
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    data[i] = static_cast< char >(value >> (8 * i));
+  }
+  writeBytes(data, length);
+}
+
+void bendryshev::SnapshotWriter::writeName(const std::string& name)
+{
+  writeInteger(name.size(), sizeof(std::uint32_t));
+  writeBytes(name.data(), name.size());
+}
+
+bendryshev::Snapshot::Snapshot(const std::string& path, Verification verification):
+  file_(path),
+  lists_(),
+  positions_()
+{
+  const char* first = file_.begin();
+  const char* last = file_.end();
+  if (file_.size() < header_size + checksum_size || std::memcmp(first, snapshot_magic, sizeof(snapshot_magic)) != 0)
+  {
+    throw std::invalid_argument("not a snapshot");
+  }
+  std::uint64_t version = loadLittleEndian(first + sizeof(snapshot_magic), sizeof(std::uint32_t));
+  if (version == 0 || version > snapshot_version)
+  {
+    throw std::invalid_argument("unsupported snapshot version");
+  }
+  // Version 1 files carry only the whole-body checksum, so they are always checked in full.
+  bool has_table_checksum = version >= table_checksum_version;
+  std::size_t trailer_size = has_table_checksum ? 2 * checksum_size : checksum_size;
+  if (file_.size() < header_size + trailer_size)
+  {
+    throw std::invalid_argument("not a snapshot");
+  }
+  const char* body_last = last - trailer_size;
+  if (verification == verify_all || !has_table_checksum)
+  {
+    if (updateChecksum(fnv_offset_basis, first, body_last - first) != loadLittleEndian(last - checksum_size, checksum_size))
+    {
+      throw std::invalid_argument("snapshot checksum mismatch");
+    }
+  }
+  TableReader table(first + sizeof(snapshot_magic) + sizeof(std::uint32_t), body_last);
+  table.readInteger(sizeof(std::uint32_t));
+  std::uint64_t list_count = table.readInteger(sizeof(std::uint32_t));
+  std::uint64_t position_count = table.readInteger(sizeof(std::uint32_t));
+  for (std::uint64_t i = 0; i < list_count; ++i)
+  {
+    std::string name = table.readName();
+    std::size_t size = table.readInteger(sizeof(std::uint64_t));
+    lists_.pushBack(SnapshotEntry { std::move(name), 0, nullptr, size });
+  }
+  for (std::uint64_t i = 0; i < position_count; ++i)
+  {
+    std::string name = table.readName();
+    std::int32_t index = static_cast< std::int32_t >(table.readInteger(sizeof(std::uint32_t)));
+    std::size_t size = table.readInteger(sizeof(std::uint64_t));
+    positions_.pushBack(SnapshotEntry { std::move(name), index, nullptr, size });
+  }
+  table.take(alignedOffset(table.current() - first) - (table.current() - first));
+  if (has_table_checksum && updateChecksum(fnv_offset_basis, first, table.current() - first) != loadLittleEndian(body_last, checksum_size))
+  {
+    throw std::invalid_argument("snapshot checksum mismatch");
+  }
+  for (auto&& entry: lists_)
+  {
+    entry.values_ = table.takeValues(entry.size_);
+  }
+  for (auto&& entry: positions_)
+  {
+    entry.values_ = table.takeValues(entry.size_);
+  }
+  if (table.current() != body_last)
+  {
+    throw std::invalid_argument("trailing data in snapshot");
+  }
+}
+
+const bendryshev::BidirectionalList< bendryshev::SnapshotEntry >& bendryshev::Snapshot::lists() const noexcept
+{
+  return lists_;
+}
+
+const bendryshev::BidirectionalList< bendryshev::SnapshotEntry >& bendryshev::Snapshot::positions() const noexcept
+{
+  return positions_;
+}
+
+void bendryshev::Snapshot::readValues(const SnapshotEntry& entry, BidirectionalList< int >& values)
+{
+  for (std::size_t i = 0; i < entry.size_; ++i)
+  {
+    values.pushBack(loadLittleEndian32(entry.values_ + i * sizeof(std::int32_t)));
+  }
+}
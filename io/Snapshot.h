@@ -0,0 +1,94 @@
+#ifndef S3_SNAPSHOT_H
+#define S3_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "data_structures/BidirectionalList.h"
+#include "io/MappedFile.h"
+#include "io/OutputSink.h"
+
+namespace bendryshev
+{
+  std::int32_t loadLittleEndian32(const char*) noexcept;
+  void storeLittleEndian32(char*, std::uint32_t) noexcept;
+
+  class SnapshotWriter
+  {
+  public:
+    SnapshotWriter(const std::string&, std::uint32_t lists, std::uint32_t positions);
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+    ~SnapshotWriter();
+
+    void writeListHeader(const std::string&, std::uint64_t size);
+    void writePositionHeader(const std::string&, std::int32_t index, std::uint64_t size);
+    template< typename ConstIterator >
+    void writeValues(ConstIterator, ConstIterator);
+    void finish();
+  private:
+    static constexpr std::size_t values_block = 1024;
+
+    int fd_;
+    std::string path_;
+    OutputSink out_;
+    std::uint64_t offset_;
+    std::uint64_t checksum_;
+    std::uint64_t table_checksum_;
+    bool data_started_;
+
+    void beginData();
+    void writeBytes(const char*, std::size_t);
+    void writeInteger(std::uint64_t, std::size_t);
+    void writeName(const std::string&);
+  };
+
+  struct SnapshotEntry
+  {
+    std::string name_;
+    std::int32_t index_;
+    const char* values_;
+    std::size_t size_;
+  };
+
+  class Snapshot
+  {
+  public:
+    enum Verification
+    {
+      verify_all,
+      verify_table
+    };
+
+    explicit Snapshot(const std::string&, Verification = verify_all);
+
+    const BidirectionalList< SnapshotEntry >& lists() const noexcept;
+    const BidirectionalList< SnapshotEntry >& positions() const noexcept;
+    static void readValues(const SnapshotEntry&, BidirectionalList< int >&);
+  private:
+    MappedFile file_;
+    BidirectionalList< SnapshotEntry > lists_;
+    BidirectionalList< SnapshotEntry > positions_;
+  };
+
+  template< typename ConstIterator >
+  void SnapshotWriter::writeValues(ConstIterator first, ConstIterator last)
+  {
+    beginData();
+    char block[values_block * sizeof(std::int32_t)];
+    std::size_t count = 0;
+    while (first != last)
+    {
+      storeLittleEndian32(block + count * sizeof(std::int32_t), static_cast< std::uint32_t >(*first));
+      ++first;
+      if (++count == values_block)
+      {
+        writeBytes(block, sizeof(block));
+        count = 0;
+      }
+    }
+    writeBytes(block, count * sizeof(std::int32_t));
+  }
+}
+
+#endif
@@ -0,0 +1,172 @@
+#include "io/Trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include "data_structures/BidirectionalList.h"
+#include "data_structures/ContainerTracing.h"
+
+namespace
+{
+  constexpr std::size_t ring_capacity = 1 << 14;
+  constexpr std::size_t max_name_length = 31;
+
+  struct TraceEvent
+  {
+    char name_[max_name_length + 1];
+    std::uint64_t start_;
+    std::uint64_t finish_;
+  };
+
+  struct TraceBuffer
+  {
+    explicit TraceBuffer(unsigned thread_id):
+      thread_id_(thread_id),
+      recorded_(0),
+      events_(new TraceEvent[ring_capacity])
+    {}
+
+    unsigned thread_id_;
+    std::size_t recorded_;
+    std::unique_ptr< TraceEvent[] > events_;
+  };
+
+  std::mutex& registryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  bendryshev::BidirectionalList< std::unique_ptr< TraceBuffer > >& registry()
+  {
+    static bendryshev::BidirectionalList< std::unique_ptr< TraceBuffer > > buffers;
+    return buffers;
+  }
+
+  TraceBuffer* threadBuffer()
+  {
+    thread_local TraceBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+      std::lock_guard< std::mutex > lock(registryMutex());
+      unsigned thread_id = static_cast< unsigned >(registry().getSize()) + 1;
+      registry().pushBack(std::make_unique< TraceBuffer >(thread_id));
+      buffer = registry().getBackData().get();
+    }
+    return buffer;
+  }
+
+  void writeEscaped(std::ostream& out, const char* name)
+  {
+    for (const char* c = name; *c; ++c)
+    {
+      if (*c == '"' || *c == '\\')
+      {
+        out << '\\' << *c;
+      }
+      else if (static_cast< unsigned char >(*c) < 0x20)
+      {
+        out << ' ';
+      }
+      else
+      {
+        out << *c;
+      }
+    }
+  }
+
+  void writeMicroseconds(std::ostream& out, std::uint64_t nanoseconds)
+  {
+    std::uint64_t fraction = nanoseconds % 1000;
+    out << nanoseconds / 1000 << '.' << fraction / 100 << (fraction / 10) % 10 << fraction % 10;
+  }
+}
+
+std::atomic< bool > bendryshev::trace::enabled(false);
+
+void bendryshev::trace::start() noexcept
+{
+  enabled.store(true, std::memory_order_relaxed);
+  container_tracing::recorder.store(&record, std::memory_order_relaxed);
+}
+
+void bendryshev::trace::stop() noexcept
+{
+  enabled.store(false, std::memory_order_relaxed);
+  container_tracing::recorder.store(nullptr, std::memory_order_relaxed);
+}
+
+std::uint64_t bendryshev::trace::now() noexcept
+{
+  return container_tracing::now();
+}
+
+void bendryshev::trace::record(const char* name, std::size_t length, std::uint64_t start, std::uint64_t finish) noexcept
+{
+  TraceBuffer* buffer = nullptr;
+  try
+  {
+    buffer = threadBuffer();
+  }
+  catch (const std::exception&)
+  {
+    return;
+  }
+  TraceEvent& event = buffer->events_[buffer->recorded_ % ring_capacity];
+  if (length == 0)
+  {
+    length = std::strlen(name);
+  }
+  length = length < max_name_length ? length : max_name_length;
+  std::memcpy(event.name_, name, length);
+  event.name_[length] = '\0';
+  event.start_ = start;
+  event.finish_ = finish;
+  ++buffer->recorded_;
+}
+
+void bendryshev::trace::writeChromeTrace(const std::string& path)
+{
+  std::ofstream out(path, std::ios::out | std::ios::trunc);
+  if (!out)
+  {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  std::lock_guard< std::mutex > lock(registryMutex());
+  std::uint64_t origin = UINT64_MAX;
+  for (auto&& buffer: registry())
+  {
+    std::size_t first = buffer->recorded_ > ring_capacity ? buffer->recorded_ - ring_capacity : 0;
+    for (std::size_t i = first; i < buffer->recorded_; ++i)
+    {
+      origin = std::min(origin, buffer->events_[i % ring_capacity].start_);
+    }
+  }
+  out << "{\"traceEvents\":[";
+  bool first_event = true;
+  for (auto&& buffer: registry())
+  {
+    std::size_t first = buffer->recorded_ > ring_capacity ? buffer->recorded_ - ring_capacity : 0;
+    for (std::size_t i = first; i < buffer->recorded_; ++i)
+    {
+      const TraceEvent& event = buffer->events_[i % ring_capacity];
+      out << (first_event ? "\n" : ",\n") << "{\"name\":\"";
+      writeEscaped(out, event.name_);
+      out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id_ << ",\"ts\":";
+      writeMicroseconds(out, event.start_ - origin);
+      out << ",\"dur\":";
+      writeMicroseconds(out, event.finish_ - event.start_);
+      out << '}';
+      first_event = false;
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  if (!out.flush())
+  {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef S3_TRACE_H
+#define S3_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef S3_TRACING
+#define S3_TRACING 1
+#endif
+
+namespace bendryshev
+{
+  namespace trace
+  {
+    extern std::atomic< bool > enabled;
+
+    inline bool isEnabled() noexcept
+    {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    void start() noexcept;
+    void stop() noexcept;
+    std::uint64_t now() noexcept;
+    void record(const char*, std::size_t, std::uint64_t start, std::uint64_t finish) noexcept;
+    void writeChromeTrace(const std::string&);
+  }
+
+  class TraceSpan
+  {
+  public:
+    explicit TraceSpan(const char* name) noexcept:
+      TraceSpan(name, 0)
+    {}
+
+    explicit TraceSpan(const std::string& name) noexcept:
+      TraceSpan(name.data(), name.size())
+    {}
+
+    TraceSpan(const char* name, std::size_t length) noexcept:
+      name_(name),
+      length_(length),
+      start_(trace::isEnabled() ? trace::now() : 0)
+    {}
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan()
+    {
+      if (start_ != 0)
+      {
+        trace::record(name_, length_, start_, trace::now());
+      }
+    }
+  private:
+    const char* name_;
+    std::size_t length_;
+    std::uint64_t start_;
+  };
+}
+
+#define S3_TRACE_CONCAT_IMPL(a, b) a##b
+#define S3_TRACE_CONCAT(a, b) S3_TRACE_CONCAT_IMPL(a, b)
+#if S3_TRACING
+#define S3_TRACE_SPAN(name) bendryshev::TraceSpan S3_TRACE_CONCAT(s3_trace_span_, __LINE__)(name)
+#else
+#define S3_TRACE_SPAN(name) static_cast< void >(0)
+#endif
+
+#endif
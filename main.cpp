@@ -1,33 +1,362 @@
 #include <iostream>
-#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <unistd.h>
 #include "data_structures/BidirectionalList.h"
+#include "commands/CommandPipeline.h"
+#include "commands/CommandServer.h"
 #include "commands/ListsCommandMaker.h"
+#include "commands/ShardedEngine.h"
+#include "io/OutputSink.h"
+#include "io/PerfCounters.h"
+#include "io/Trace.h"
+
+namespace
+{
+  struct Options
+  {
+    const char* list_file = nullptr;
+    const char* snapshot_file = nullptr;
+    const char* mapped_file = nullptr;
+    const char* journal_file = nullptr;
+    const char* socket_path = nullptr;
+    const char* trace_file = nullptr;
+    unsigned short tcp_port = 0;
+    unsigned threads = 1;
+    bool lazy = false;
+    bool dump_stats = false;
+    bool perf_counters = false;
+    bool pipeline = false;
+  };
+
+  bool parseOptions(int argc, char** argv, Options& options)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], "--lazy") == 0)
+      {
+        options.lazy = true;
+      }
+      else if (std::strcmp(argv[i], "--stats") == 0)
+      {
+        options.dump_stats = true;
+      }
+      else if (std::strcmp(argv[i], "--perf") == 0)
+      {
+        options.perf_counters = true;
+        options.dump_stats = true;
+      }
+      else if (std::strcmp(argv[i], "--pipeline") == 0)
+      {
+        options.pipeline = true;
+      }
+      else if (std::strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc)
+      {
+        options.snapshot_file = argv[++i];
+      }
+      else if (std::strcmp(argv[i], "--map") == 0 && i + 1 < argc)
+      {
+        options.mapped_file = argv[++i];
+      }
+      else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc)
+      {
+        options.journal_file = argv[++i];
+      }
+      else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+      {
+        options.trace_file = argv[++i];
+      }
+      else if (std::strcmp(argv[i], "--listen") == 0 && i + 1 < argc)
+      {
+        options.socket_path = argv[++i];
+      }
+      else if (std::strcmp(argv[i], "--tcp") == 0 && i + 1 < argc)
+      {
+        char* last = nullptr;
+        unsigned long port = std::strtoul(argv[++i], std::addressof(last), 10);
+        if (*last != '\0' || port == 0 || port > 65535)
+        {
+          return false;
+        }
+        options.tcp_port = static_cast< unsigned short >(port);
+      }
+      else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+      {
+        char* last = nullptr;
+        unsigned long threads = std::strtoul(argv[++i], std::addressof(last), 10);
+        if (*last != '\0' || threads == 0 || threads > 256)
+        {
+          return false;
+        }
+        options.threads = static_cast< unsigned >(threads);
+      }
+      else if (argv[i][0] != '-' && !options.list_file)
+      {
+        options.list_file = argv[i];
+      }
+      else
+      {
+        return false;
+      }
+    }
+    int sources = (options.list_file != nullptr) + (options.snapshot_file != nullptr) + (options.mapped_file != nullptr);
+    bool server = options.socket_path || options.tcp_port != 0;
+    return sources == 1 && !((options.journal_file || server) && options.threads > 1) && !(server && options.pipeline);
+  }
+
+  bool loadInitialState(bendryshev::CommandMaker& cmd, const Options& options)
+  {
+    try
+    {
+      if (options.snapshot_file || options.mapped_file)
+      {
+        try
+        {
+          if (options.snapshot_file)
+          {
+            cmd.loadState(options.snapshot_file);
+          }
+          else
+          {
+            cmd.mapLists(options.mapped_file);
+          }
+        }
+        catch (const std::invalid_argument&)
+        {
+          std::cerr << "Snapshot is corrupted\n";
+          return false;
+        }
+      }
+      else if (options.lazy)
+      {
+        cmd.loadListsLazily(options.list_file);
+      }
+      else
+      {
+        cmd.loadLists(options.list_file);
+      }
+    }
+    catch (const std::system_error&)
+    {
+      std::cerr << "File can not be opened\n";
+      return false;
+    }
+    catch (const std::invalid_argument&)
+    {
+      std::cerr << "List file is corrupted\n";
+      return false;
+    }
+    return true;
+  }
+
+  bool openJournal(bendryshev::CommandMaker& cmd, const Options& options)
+  {
+    try
+    {
+      if (options.journal_file)
+      {
+        cmd.openJournal(options.journal_file);
+      }
+    }
+    catch (const std::system_error&)
+    {
+      std::cerr << "Journal can not be opened\n";
+      return false;
+    }
+    catch (const std::exception&)
+    {
+      std::cerr << "Journal is corrupted\n";
+      return false;
+    }
+    return true;
+  }
+
+  void writeTrace(const Options& options)
+  {
+    if (!options.trace_file)
+    {
+      return;
+    }
+    bendryshev::trace::stop();
+    try
+    {
+      bendryshev::trace::writeChromeTrace(options.trace_file);
+    }
+    catch (const std::system_error&)
+    {
+      std::cerr << "Trace can not be written\n";
+    }
+  }
+
+  template< typename Engine >
+  void dumpStats(Engine& engine, const Options& options)
+  {
+#if S3_COMMAND_STATS
+    if (options.dump_stats)
+    {
+      bendryshev::OutputSink err(STDERR_FILENO);
+      engine.stats().print(err);
+    }
+#else
+    static_cast< void >(engine);
+    static_cast< void >(options);
+#endif
+  }
+
+  int serve(const Options& options)
+  {
+    bendryshev::CommandServer server;
+    if (!loadInitialState(server.maker(), options) || !openJournal(server.maker(), options))
+    {
+      return 1;
+    }
+    try
+    {
+      if (options.socket_path)
+      {
+        server.listenUnix(options.socket_path);
+      }
+      if (options.tcp_port != 0)
+      {
+        server.listenTcp(options.tcp_port);
+      }
+      server.run();
+    }
+    catch (const std::system_error& e)
+    {
+      std::cerr << "Server error: " << e.what() << '\n';
+      return 1;
+    }
+    server.maker().flush();
+    dumpStats(server.maker(), options);
+    writeTrace(options);
+    return 0;
+  }
+
+  void submit(bendryshev::CommandMaker& cmd, const std::string& line)
+  {
+    S3_TRACE_SPAN("command");
+    cmd.doCommand(line);
+  }
+
+  void submit(bendryshev::ShardedEngine& engine, const std::string& line)
+  {
+    S3_TRACE_SPAN("submit");
+    engine.submit(bendryshev::split(line));
+  }
+
+  void submit(bendryshev::CommandMaker& cmd, bendryshev::CommandRecord& record)
+  {
+    S3_TRACE_SPAN("command");
+    cmd.doCommand(record.line_, std::move(record.tokens_));
+  }
+
+  void submit(bendryshev::ShardedEngine& engine, bendryshev::CommandRecord& record)
+  {
+    S3_TRACE_SPAN("submit");
+    engine.submit(std::move(record.tokens_));
+  }
+
+  template< typename Engine >
+  void processPipelined(Engine& engine)
+  {
+    bendryshev::CommandPipeline pipeline(std::cin);
+    pipeline.start();
+    bendryshev::CommandRecord record {};
+    while (pipeline.next(record))
+    {
+      if (!record.line_.empty())
+      {
+        submit(engine, record);
+      }
+      if (record.drained_)
+      {
+        engine.flush();
+      }
+    }
+    engine.flush();
+  }
+
+  template< typename Engine >
+  void processInput(Engine& engine, const Options& options)
+  {
+    if (options.pipeline)
+    {
+      processPipelined(engine);
+      return;
+    }
+    std::string s;
+    for (;;)
+    {
+      {
+        S3_TRACE_SPAN("readLine");
+        if (!std::getline(std::cin, s))
+        {
+          break;
+        }
+      }
+      if (!s.empty())
+      {
+        submit(engine, s);
+      }
+      if (std::cin.rdbuf()->in_avail() <= 0)
+      {
+        engine.flush();
+      }
+    }
+    engine.flush();
+  }
+
+  int runSharded(bendryshev::OutputSink& out, const Options& options)
+  {
+    bendryshev::ShardedEngine engine(out, options.threads);
+    if (!loadInitialState(engine.loader(), options))
+    {
+      return 1;
+    }
+    engine.start();
+    processInput(engine, options);
+    dumpStats(engine, options);
+    return 0;
+  }
+}
 
 int main(int argc, char** argv)
 {
-  if (argc != 2)
+  Options options;
+  if (!parseOptions(argc, argv, options))
   {
     std::cerr << "Wrong command line params\n";
     return 1;
   }
-  std::ifstream fin(argv[1]);
-  if (!fin)
+  if (options.trace_file)
   {
-    std::cerr << "File can not be opened\n";
-    return 1;
+    bendryshev::trace::start();
   }
-  bendryshev::CommandMaker cmd(std::cout);
-  cmd.readLists(fin);
-  fin.close();
-  std::string s;
-  while (std::getline(std::cin, s))
+  if (options.perf_counters && !bendryshev::perf::start())
   {
-    if (s.empty())
-    {
-      continue;
-    }
-    bendryshev::BidirectionalList< std::string > command = bendryshev::split(s);
-    cmd.doCommand(command);
+    std::cerr << "Performance counters are unavailable\n";
+  }
+  if (options.socket_path || options.tcp_port != 0)
+  {
+    return serve(options);
+  }
+  std::ios::sync_with_stdio(false);
+  bendryshev::OutputSink out(STDOUT_FILENO);
+  if (options.threads > 1)
+  {
+    int result = runSharded(out, options);
+    writeTrace(options);
+    return result;
+  }
+  bendryshev::CommandMaker cmd(out);
+  if (!loadInitialState(cmd, options) || !openJournal(cmd, options))
+  {
+    return 1;
   }
+  processInput(cmd, options);
+  dumpStats(cmd, options);
+  writeTrace(options);
   return 0;
 }
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include "data_structures/BidirectionalList.h"
+
+namespace
+{
+  using list = bendryshev::BidirectionalList< int >;
+
+  int failures = 0;
+
+  list::Iterator at(list& values, int index)
+  {
+    list::Iterator it = values.begin();
+    for (int i = 0; i < index; ++i)
+    {
+      ++it;
+    }
+    return it;
+  }
+
+  // Walks the list both ways, so a relink that left a stale back pointer fails as well as a wrong order.
+  void expect(const char* name, list& values, const std::vector< int >& expected)
+  {
+    std::vector< int > forward;
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+      forward.push_back(*it);
+    }
+    std::vector< int > backward;
+    if (!values.isEmpty())
+    {
+      list::Iterator it = at(values, static_cast< int >(forward.size()) - 1);
+      for (;; --it)
+      {
+        backward.insert(backward.begin(), *it);
+        if (it == values.begin())
+        {
+          break;
+        }
+      }
+    }
+    if (forward != expected || backward != expected || values.getSize() != expected.size())
+    {
+      ++failures;
+      std::cerr << name << ": got";
+      for (int value: forward)
+      {
+        std::cerr << ' ' << value;
+      }
+      std::cerr << '\n';
+    }
+  }
+
+  void expectValue(const char* name, list::Iterator it, int expected)
+  {
+    if (*it != expected)
+    {
+      ++failures;
+      std::cerr << name << ": iterator moved to " << *it << '\n';
+    }
+  }
+
+  void testSplice()
+  {
+    list values { 1, 2, 3 };
+    list other { 7, 8 };
+    values.splice(at(values, 1), other);
+    expect("splice into the middle", values, { 1, 7, 8, 2, 3 });
+    expect("splice leaves the source empty", other, {});
+
+    list empty;
+    list source { 4, 5 };
+    empty.splice(empty.end(), source);
+    expect("splice into an empty list", empty, { 4, 5 });
+
+    list tail { 6 };
+    empty.splice(empty.end(), tail);
+    expect("splice at the end", empty, { 4, 5, 6 });
+
+    empty.splice(empty.begin(), empty);
+    expect("splice of a list into itself", empty, { 4, 5, 6 });
+  }
+
+  void testRangeSplice()
+  {
+    list values { 1, 2, 3 };
+    list other { 6, 7, 8, 9 };
+    list::Iterator seven = at(other, 1);
+    values.splice(values.begin(), other, seven, at(other, 3));
+    expect("range splice to the front", values, { 7, 8, 1, 2, 3 });
+    expect("range splice source", other, { 6, 9 });
+    expectValue("range splice keeps nodes", seven, 7);
+
+    values.splice(values.end(), other, other.begin(), other.begin());
+    expect("empty range splice", values, { 7, 8, 1, 2, 3 });
+    expect("empty range splice source", other, { 6, 9 });
+
+    values.splice(values.end(), values, values.begin(), at(values, 2));
+    expect("range splice within one list", values, { 1, 2, 3, 7, 8 });
+
+    values.splice(values.begin(), other, other.begin(), other.end());
+    expect("whole list range splice", values, { 6, 9, 1, 2, 3, 7, 8 });
+    expect("whole list range splice source", other, {});
+  }
+
+  void testSwapRanges()
+  {
+    list values { 1, 2, 3, 4, 5, 6, 7 };
+    list::Iterator one = values.begin();
+    list::Iterator four = at(values, 3);
+    values.swapRanges(at(values, 0), at(values, 1), at(values, 3), at(values, 6));
+    expect("swapRanges with a gap", values, { 4, 5, 6, 2, 3, 1, 7 });
+    expectValue("swapRanges keeps the lower node", one, 1);
+    expectValue("swapRanges keeps the upper node", four, 4);
+
+    list adjacent { 1, 2, 3, 4, 5 };
+    adjacent.swapRanges(at(adjacent, 0), at(adjacent, 2), at(adjacent, 2), adjacent.end());
+    expect("swapRanges of adjacent ranges", adjacent, { 3, 4, 5, 1, 2 });
+
+    list lower_empty { 1, 2, 3, 4 };
+    lower_empty.swapRanges(lower_empty.begin(), lower_empty.begin(), at(lower_empty, 2), lower_empty.end());
+    expect("swapRanges with an empty lower range", lower_empty, { 3, 4, 1, 2 });
+
+    list upper_empty { 1, 2, 3, 4 };
+    upper_empty.swapRanges(upper_empty.begin(), at(upper_empty, 2), at(upper_empty, 3), at(upper_empty, 3));
+    expect("swapRanges with an empty upper range", upper_empty, { 3, 1, 2, 4 });
+
+    list both_empty { 1, 2, 3 };
+    both_empty.swapRanges(at(both_empty, 1), at(both_empty, 1), at(both_empty, 1), at(both_empty, 1));
+    expect("swapRanges of two empty ranges", both_empty, { 1, 2, 3 });
+
+    list whole { 1, 2, 3 };
+    whole.swapRanges(whole.begin(), whole.end(), whole.end(), whole.end());
+    expect("swapRanges of the whole list with an empty range", whole, { 1, 2, 3 });
+
+    list halves { 1, 2, 3, 4 };
+    halves.swapRanges(halves.begin(), at(halves, 2), at(halves, 2), halves.end());
+    expect("swapRanges of two halves", halves, { 3, 4, 1, 2 });
+    halves.pushBack(5);
+    halves.pushFront(0);
+    expect("swapRanges leaves both ends linked", halves, { 0, 3, 4, 1, 2, 5 });
+  }
+}
+
+int main()
+{
+  testSplice();
+  testRangeSplice();
+  testSwapRanges();
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "commands/ListsCommandMaker.h"
+
+namespace
+{
+  int failures = 0;
+
+  void expect(const char* name, const std::string& lists, std::initializer_list< const char* > commands,
+    const std::string& expected)
+  {
+    std::ostringstream out;
+    {
+      bendryshev::CommandMaker maker(out);
+      std::istringstream in(lists);
+      maker.readLists(in);
+      for (const char* command: commands)
+      {
+        maker.doCommand(command);
+      }
+      maker.flush();
+    }
+    if (out.str() != expected)
+    {
+      ++failures;
+      std::cerr << name << ":\n--- expected\n" << expected << "--- got\n" << out.str();
+    }
+  }
+
+  void testRotate()
+  {
+    expect("rotate keeps bystanders at their index", "a 1 2 3 4 5 6\n",
+      { "begin p1 a", "find p2 a 3", "find p3 a 4", "find p4 a 6", "find x a 2", "rotate p1 p2 p3 p4", "print a",
+        "printPos x", "search r x p4 5", "printPos r" },
+      "a 4 5 3 1 2 6\nx 1\nr 1\n");
+    expect("rotate across two lists", "a 1 2 3\nb 7 8 9\n",
+      { "begin p1 a", "find p2 a 3", "begin p3 b", "find p4 b 9", "rotate p1 p2 p3 p4", "print a", "print b" },
+      "a 7 8 3\nb 1 2 9\n");
+    expect("rotate of unequal ranges", "a 1 2 3 4\n",
+      { "begin p1 a", "find p2 a 2", "find p3 a 3", "end p4 a", "rotate p1 p2 p3 p4", "print a" },
+      "<INVALID COMMAND>\na 1 2 3 4\n");
+  }
+
+  void testSwapRanges()
+  {
+    expect("swapRanges moves bystanders with their nodes", "a 1 2 3 4 5 6 7\n",
+      { "begin p1 a", "find p2 a 2", "find p3 a 4", "find p4 a 7", "find x a 1", "find y a 3", "find z a 5",
+        "swapRanges p1 p2 p3 p4", "print a", "printPos x", "printPos y", "printPos z", "search r y p4 3", "printPos r" },
+      "a 4 5 6 2 3 1 7\nx 5\ny 4\nz 1\nr 4\n");
+    expect("swapRanges of adjacent ranges and back", "a 1 2 3 4 5\n",
+      { "begin p1 a", "find p2 a 3", "find p3 a 3", "end p4 a", "swapRanges p1 p2 p3 p4", "print a", "printPos p3",
+        "swapRanges p1 p2 p3 p4", "print a" },
+      "a 3 4 5 1 2\np3 3\na 1 2 3 4 5\n");
+    expect("swapRanges with an empty range", "a 1 2 3 4\n",
+      { "begin p1 a", "begin p2 a", "find p3 a 3", "end p4 a", "swapRanges p1 p2 p3 p4", "print a" },
+      "a 3 4 1 2\n");
+    expect("swapRanges of the whole list", "a 1 2 3\n",
+      { "begin p1 a", "end p2 a", "end p3 a", "end p4 a", "swapRanges p1 p2 p3 p4", "print a",
+        "search r p1 p2 1", "printPos r" },
+      "a 1 2 3\nr 0\n");
+    expect("swapRanges of a lazily concatenated list", "a 1 2\nb 3 4\n",
+      { "concat c a b", "begin p1 c", "find p2 c 2", "find p3 c 3", "find p4 c 4", "swapRanges p1 p2 p3 p4",
+        "print c", "print a" },
+      "c 3 2 1 4\na 1 2\n");
+  }
+
+  void testStalePositions()
+  {
+    expect("positions past the end after remove", "a 1 2 3 4 5 6\n",
+      { "begin p1 a", "find p2 a 2", "find p3 a 5", "end p4 a", "remove a 1", "swapRanges p1 p2 p3 p4", "print a" },
+      "<INVALID COMMAND>\na 2 3 4 5 6\n");
+    expect("positions re-resolved by index after replace", "a 1 2 3 4 5 6\n",
+      { "begin p1 a", "find p2 a 2", "find p3 a 5", "end p4 a", "replace a 2 20", "swapRanges p1 p2 p3 p4", "print a" },
+      "a 5 6 20 3 4 1\n");
+    expect("positions past the end after the list is replaced", "a 1 2 3 4\nb 7\n",
+      { "begin p1 a", "find p2 a 2", "find p3 a 3", "end p4 a", "concat a b b", "rotate p1 p2 p3 p4", "print a" },
+      "<INVALID COMMAND>\na 7 7\n");
+  }
+}
+
+int main()
+{
+  testRotate();
+  testSwapRanges();
+  testStalePositions();
+  return failures == 0 ? 0 : 1;
+}